@@ -0,0 +1,74 @@
+#include "JointMap.h"
+
+namespace Animation
+{
+	JointMap::JointMap(const ozz::animation::Skeleton* a_skeleton)
+	{
+		Build(a_skeleton);
+	}
+
+	void JointMap::Build(const ozz::animation::Skeleton* a_skeleton)
+	{
+		slots.clear();
+		mask = 0;
+		count = 0;
+
+		if (!a_skeleton)
+			return;
+
+		auto names = a_skeleton->joint_names();
+
+		//Keep the load factor at or below 50% so probe chains stay short.
+		size_t capacity = std::bit_ceil(std::max<size_t>(names.size() * 2, 8));
+		slots.resize(capacity);
+		mask = capacity - 1;
+
+		std::hash<std::string_view> hasher;
+		for (size_t i = 0; i < names.size(); i++) {
+			std::string_view name = names[i];
+			size_t h = hasher(name);
+			for (size_t pos = h & mask;; pos = (pos + 1) & mask) {
+				auto& s = slots[pos];
+				if (s.index == npos) {
+					s.name = name;
+					s.hash = h;
+					s.index = i;
+					count++;
+					break;
+				}
+
+				//Duplicate joint names resolve to the last occurrence, same as the std::map this replaces.
+				if (s.hash == h && s.name == name) {
+					s.index = i;
+					break;
+				}
+			}
+		}
+	}
+
+	size_t JointMap::find(const std::string_view a_name) const
+	{
+		if (slots.empty())
+			return npos;
+
+		size_t h = std::hash<std::string_view>{}(a_name);
+		for (size_t pos = h & mask;; pos = (pos + 1) & mask) {
+			auto& s = slots[pos];
+			if (s.index == npos)
+				return npos;
+
+			if (s.hash == h && s.name == a_name)
+				return s.index;
+		}
+	}
+
+	size_t JointMap::size() const
+	{
+		return count;
+	}
+
+	bool JointMap::empty() const
+	{
+		return count == 0;
+	}
+}
\ No newline at end of file
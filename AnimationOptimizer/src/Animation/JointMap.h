@@ -0,0 +1,32 @@
+#pragma once
+
+namespace Animation
+{
+	//Flat, open-addressed table of joint name -> joint index, built once per skeleton.
+	//Keys are views into the skeleton's own name storage, so the skeleton must outlive the map.
+	class JointMap
+	{
+	public:
+		static constexpr size_t npos = UINT64_MAX;
+
+		JointMap() = default;
+		explicit JointMap(const ozz::animation::Skeleton* a_skeleton);
+
+		void Build(const ozz::animation::Skeleton* a_skeleton);
+		size_t find(const std::string_view a_name) const;
+		size_t size() const;
+		bool empty() const;
+
+	private:
+		struct Slot
+		{
+			std::string_view name;
+			size_t hash = 0;
+			size_t index = npos;
+		};
+
+		std::vector<Slot> slots;
+		size_t mask = 0;
+		size_t count = 0;
+	};
+}
\ No newline at end of file
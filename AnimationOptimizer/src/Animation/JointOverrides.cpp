@@ -0,0 +1,120 @@
+#include "JointOverrides.h"
+#include "simdjson.h"
+
+namespace Animation
+{
+	namespace
+	{
+		bool CharEquals(char a_lhs, char a_rhs)
+		{
+			return std::tolower(static_cast<unsigned char>(a_lhs)) == std::tolower(static_cast<unsigned char>(a_rhs));
+		}
+
+		//Iterative glob match, backtracking only to the most recent '*'.
+		bool GlobMatch(std::string_view a_pattern, std::string_view a_str)
+		{
+			size_t p = 0;
+			size_t s = 0;
+			size_t starP = std::string_view::npos;
+			size_t starS = 0;
+
+			while (s < a_str.size()) {
+				if (p < a_pattern.size() && (a_pattern[p] == '?' || (a_pattern[p] != '*' && CharEquals(a_pattern[p], a_str[s])))) {
+					p++;
+					s++;
+				} else if (p < a_pattern.size() && a_pattern[p] == '*') {
+					starP = p++;
+					starS = s;
+				} else if (starP != std::string_view::npos) {
+					p = starP + 1;
+					s = ++starS;
+				} else {
+					return false;
+				}
+			}
+
+			while (p < a_pattern.size() && a_pattern[p] == '*') {
+				p++;
+			}
+			return p == a_pattern.size();
+		}
+	}
+
+	std::filesystem::path JointOverrides::GetSidecarPath(const std::filesystem::path& a_skeletonPath)
+	{
+		auto result = a_skeletonPath;
+		result.replace_extension(".overrides.json");
+		return result;
+	}
+
+	bool JointOverrides::Load(const std::filesystem::path& a_path)
+	{
+		entries.clear();
+
+		std::error_code ec;
+		if (!std::filesystem::exists(a_path, ec))
+			return true;
+
+		simdjson::padded_string json;
+		if (simdjson::padded_string::load(a_path.string()).get(json) != simdjson::error_code::SUCCESS)
+			return false;
+
+		simdjson::dom::parser parser;
+		simdjson::dom::element root;
+		if (parser.parse(json).get(root) != simdjson::error_code::SUCCESS)
+			return false;
+
+		simdjson::dom::array joints;
+		if (root["joints"].get_array().get(joints) != simdjson::error_code::SUCCESS)
+			return false;
+
+		for (auto j : joints) {
+			std::string_view name;
+			if (j["name"].get_string().get(name) != simdjson::error_code::SUCCESS)
+				continue;
+
+			Entry& e = entries.emplace_back();
+			e.pattern = name;
+
+			double value;
+			if (j["tolerance"].get_double().get(value) == simdjson::error_code::SUCCESS) {
+				e.tolerance = static_cast<float>(value);
+			}
+			if (j["distance"].get_double().get(value) == simdjson::error_code::SUCCESS) {
+				e.distance = static_cast<float>(value);
+			}
+		}
+
+		return true;
+	}
+
+	bool JointOverrides::empty() const
+	{
+		return entries.empty();
+	}
+
+	void JointOverrides::Apply(const ozz::animation::Skeleton* a_skeleton, ozz::animation::offline::AnimationOptimizer& a_optimizer) const
+	{
+		if (entries.empty() || !a_skeleton)
+			return;
+
+		auto names = a_skeleton->joint_names();
+		for (size_t i = 0; i < names.size(); i++) {
+			std::optional<ozz::animation::offline::AnimationOptimizer::Setting> setting;
+			for (auto& e : entries) {
+				if (!GlobMatch(e.pattern, names[i]))
+					continue;
+
+				setting = a_optimizer.setting;
+				if (e.tolerance.has_value())
+					setting->tolerance = e.tolerance.value();
+				if (e.distance.has_value())
+					setting->distance = e.distance.value();
+			}
+
+			if (setting.has_value()) {
+				a_optimizer.joints_setting_override[static_cast<int>(i)] = setting.value();
+			}
+		}
+	}
+}
\ No newline at end of file
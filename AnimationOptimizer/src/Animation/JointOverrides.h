@@ -0,0 +1,31 @@
+#pragma once
+
+namespace Animation
+{
+	//Per-joint optimizer settings read from a sidecar next to the skeleton, <skeleton>.overrides.json:
+	//{ "joints": [ { "name": "*Finger*", "tolerance": 0.0001, "distance": 0.05 } ] }
+	//Names are case-insensitive globs supporting * and ?. When several entries match a joint the last one wins,
+	//and a missing tolerance or distance keeps the global value.
+	class JointOverrides
+	{
+	public:
+		static std::filesystem::path GetSidecarPath(const std::filesystem::path& a_skeletonPath);
+
+		//Returns false if the file exists but can't be parsed. A missing file just leaves the set empty.
+		bool Load(const std::filesystem::path& a_path);
+		bool empty() const;
+
+		//Fills a_optimizer.joints_setting_override for every matching joint, relative to its current global setting.
+		void Apply(const ozz::animation::Skeleton* a_skeleton, ozz::animation::offline::AnimationOptimizer& a_optimizer) const;
+
+	private:
+		struct Entry
+		{
+			std::string pattern;
+			std::optional<float> tolerance;
+			std::optional<float> distance;
+		};
+
+		std::vector<Entry> entries;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "PoseError.h"
+
+namespace Animation
+{
+	namespace
+	{
+		constexpr size_t PointsPerJoint = 4;
+	}
+
+	PoseErrorMeasure::PoseErrorMeasure(const ozz::animation::Skeleton* a_skeleton, std::span<const int16_t> a_parents, size_t a_sampleCount, float a_distance) :
+		skeleton(a_skeleton), sampleCount(std::max<size_t>(a_sampleCount, 2)), distance(a_distance)
+	{
+		const size_t numJoints = skeleton->num_joints();
+		if (a_parents.size() != numJoints)
+			return;
+
+		parents.assign(a_parents.begin(), a_parents.end());
+
+		//A joint whose parent chain loops or points outside the skeleton is treated as a root.
+		std::vector<size_t> depths(numJoints, 0);
+		for (size_t j = 0; j < numJoints; j++) {
+			size_t depth = 0;
+			for (int16_t p = parents[j]; p >= 0 && depth <= numJoints; p = parents[p]) {
+				if (static_cast<size_t>(p) >= numJoints) {
+					depth = numJoints + 1;
+					break;
+				}
+				depth++;
+			}
+
+			if (depth > numJoints) {
+				parents[j] = -1;
+				depth = 0;
+			}
+			depths[j] = depth;
+		}
+
+		order.resize(numJoints);
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return depths[a] < depths[b]; });
+	}
+
+	bool PoseErrorMeasure::SetReference(const ozz::animation::offline::RawAnimation& a_reference)
+	{
+		referencePoints.clear();
+		return Sample(a_reference, referencePoints);
+	}
+
+	std::optional<PoseError> PoseErrorMeasure::Measure(const ozz::animation::offline::RawAnimation& a_candidate) const
+	{
+		if (referencePoints.empty())
+			return std::nullopt;
+
+		std::vector<ozz::math::Float3> points;
+		if (!Sample(a_candidate, points) || points.size() != referencePoints.size())
+			return std::nullopt;
+
+		PoseError result;
+		double total = 0.0;
+		for (size_t i = 0; i < points.size(); i++) {
+			const float err = ozz::math::Length(points[i] - referencePoints[i]);
+			result.maxError = std::max(result.maxError, err);
+			total += err;
+		}
+		result.meanError = static_cast<float>(total / static_cast<double>(points.size()));
+		return result;
+	}
+
+	bool PoseErrorMeasure::Sample(const ozz::animation::offline::RawAnimation& a_anim, std::vector<ozz::math::Float3>& a_points) const
+	{
+		ozz::animation::offline::AnimationBuilder builder;
+		auto anim = builder(a_anim);
+		if (!anim || anim->num_tracks() != skeleton->num_joints())
+			return false;
+
+		const size_t numJoints = skeleton->num_joints();
+		std::vector<ozz::math::SoaTransform> locals(skeleton->num_soa_joints());
+		std::vector<ozz::math::Float4x4> models(numJoints);
+		ozz::animation::SamplingJob::Context context(anim->num_tracks());
+
+		const ozz::math::SimdFloat4 offsets[PointsPerJoint] = {
+			ozz::math::simd_float4::Load(0.0f, 0.0f, 0.0f, 1.0f),
+			ozz::math::simd_float4::Load(distance, 0.0f, 0.0f, 1.0f),
+			ozz::math::simd_float4::Load(0.0f, distance, 0.0f, 1.0f),
+			ozz::math::simd_float4::Load(0.0f, 0.0f, distance, 1.0f)
+		};
+
+		a_points.resize(sampleCount * numJoints * PointsPerJoint);
+		for (size_t s = 0; s < sampleCount; s++) {
+			ozz::animation::SamplingJob sampling;
+			sampling.animation = anim.get();
+			sampling.context = &context;
+			sampling.ratio = static_cast<float>(s) / static_cast<float>(sampleCount - 1);
+			sampling.output = ozz::make_span(locals);
+			if (!sampling.Run())
+				return false;
+
+			ozz::animation::LocalToModelJob ltm;
+			ltm.skeleton = skeleton;
+			ltm.input = ozz::make_span(locals);
+			ltm.output = ozz::make_span(models);
+			if (!ltm.Run())
+				return false;
+
+			for (size_t j : order) {
+				if (parents[j] >= 0) {
+					models[j] = models[parents[j]] * models[j];
+				}
+			}
+
+			ozz::math::Float3* out = &a_points[s * numJoints * PointsPerJoint];
+			for (size_t j = 0; j < numJoints; j++) {
+				for (size_t p = 0; p < PointsPerJoint; p++) {
+					ozz::math::Store3PtrU(ozz::math::TransformPoint(models[j], offsets[p]), &out->x);
+					out++;
+				}
+			}
+		}
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+namespace Animation
+{
+	struct PoseError
+	{
+		float maxError = 0.0f;
+		float meanError = 0.0f;
+	};
+
+	//Samples animations at a fixed set of uniform times and compares them in model space against a reference.
+	//Each joint contributes its origin plus three points a_distance away along its local axes, so rotation error
+	//shows up the way it would on skinned vertices. Errors are in skeleton units.
+	//Model space follows a_parents when it holds one entry per joint, since the skeletons built from glTF are flat and
+	//their own hierarchy would leave a parent's error out of its children. Otherwise the skeleton's hierarchy is used.
+	class PoseErrorMeasure
+	{
+	public:
+		PoseErrorMeasure(const ozz::animation::Skeleton* a_skeleton, std::span<const int16_t> a_parents, size_t a_sampleCount, float a_distance);
+
+		//Builds & samples the reference. Returns false if it can't be built into a runtime animation.
+		bool SetReference(const ozz::animation::offline::RawAnimation& a_reference);
+
+		//Returns nullopt if the candidate can't be built, or no reference was set.
+		std::optional<PoseError> Measure(const ozz::animation::offline::RawAnimation& a_candidate) const;
+
+	private:
+		bool Sample(const ozz::animation::offline::RawAnimation& a_anim, std::vector<ozz::math::Float3>& a_points) const;
+
+		const ozz::animation::Skeleton* skeleton;
+		std::vector<int16_t> parents;
+		//Joints ordered so every parent comes before its children.
+		std::vector<size_t> order;
+		size_t sampleCount;
+		float distance;
+		std::vector<ozz::math::Float3> referencePoints;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#include "Resample.h"
+
+namespace Animation
+{
+	namespace
+	{
+		ozz::math::Float3 Interpolate(const ozz::math::Float3& a_from, const ozz::math::Float3& a_to, float a_alpha)
+		{
+			return ozz::math::Lerp(a_from, a_to, a_alpha);
+		}
+
+		ozz::math::Quaternion Interpolate(const ozz::math::Quaternion& a_from, const ozz::math::Quaternion& a_to, float a_alpha)
+		{
+			//Shortest-path nlerp, matching how ozz interpolates rotation keys at runtime.
+			const float dot = a_from.x * a_to.x + a_from.y * a_to.y + a_from.z * a_to.z + a_from.w * a_to.w;
+			const float sign = dot < 0.0f ? -1.0f : 1.0f;
+			ozz::math::Quaternion result{
+				a_from.x + (a_to.x * sign - a_from.x) * a_alpha,
+				a_from.y + (a_to.y * sign - a_from.y) * a_alpha,
+				a_from.z + (a_to.z * sign - a_from.z) * a_alpha,
+				a_from.w + (a_to.w * sign - a_from.w) * a_alpha
+			};
+			return ozz::math::Normalize(result);
+		}
+
+		float Interpolate(float a_from, float a_to, float a_alpha)
+		{
+			return a_from + (a_to - a_from) * a_alpha;
+		}
+
+		//Walks the source keys with a forward-only cursor, so resampling a track is linear in its key count.
+		//a_getTime/a_getValue/a_make adapt this to both RawAnimation keys and RawFloatTrack keyframes.
+		template <typename Keys, typename TimeFunc, typename ValueFunc, typename MakeFunc>
+		void ResampleKeys(Keys& a_keys, const std::vector<float>& a_times, TimeFunc a_getTime, ValueFunc a_getValue, MakeFunc a_make)
+		{
+			if (a_keys.size() < 2)
+				return;
+
+			Keys result;
+			result.resize(a_times.size());
+
+			size_t cursor = 0;
+			for (size_t i = 0; i < a_times.size(); i++) {
+				const float t = a_times[i];
+				while (cursor + 1 < a_keys.size() && a_getTime(a_keys[cursor + 1]) <= t) {
+					cursor++;
+				}
+
+				auto& from = a_keys[cursor];
+				if (cursor + 1 >= a_keys.size() || t <= a_getTime(from)) {
+					a_make(result[i], t, a_getValue(from));
+					continue;
+				}
+
+				auto& to = a_keys[cursor + 1];
+				const float span = a_getTime(to) - a_getTime(from);
+				const float alpha = span > 0.0f ? (t - a_getTime(from)) / span : 0.0f;
+				a_make(result[i], t, Interpolate(a_getValue(from), a_getValue(to), alpha));
+			}
+
+			a_keys = std::move(result);
+		}
+
+		std::vector<float> MakeTimeline(float a_duration, float a_frameRate)
+		{
+			std::vector<float> result;
+			const size_t frames = static_cast<size_t>(std::ceil(a_duration * a_frameRate));
+			result.reserve(frames + 1);
+			for (size_t i = 0; i < frames; i++) {
+				const float t = static_cast<float>(i) / a_frameRate;
+				if (t >= a_duration)
+					break;
+
+				result.push_back(t);
+			}
+			result.push_back(a_duration);
+			return result;
+		}
+	}
+
+	void ResampleAnimation(RawOzzAnimation* a_anim, float a_frameRate, bool a_parallel)
+	{
+		if (!a_anim || a_frameRate <= 0.0f)
+			return;
+
+		if (a_anim->data) {
+			auto& data = *a_anim->data;
+			const std::vector<float> times = MakeTimeline(data.duration, a_frameRate);
+
+			const auto ResampleJoint = [&](ozz::animation::offline::RawAnimation::JointTrack& a_track) {
+				const auto GetTime = [](const auto& k) { return k.time; };
+				const auto GetValue = [](const auto& k) { return k.value; };
+				const auto Make = [](auto& k, float t, const auto& v) {
+					k.time = t;
+					k.value = v;
+				};
+				ResampleKeys(a_track.rotations, times, GetTime, GetValue, Make);
+				ResampleKeys(a_track.translations, times, GetTime, GetValue, Make);
+				ResampleKeys(a_track.scales, times, GetTime, GetValue, Make);
+			};
+
+			if (a_parallel) {
+				std::for_each(std::execution::par, data.tracks.begin(), data.tracks.end(), ResampleJoint);
+			} else {
+				std::for_each(data.tracks.begin(), data.tracks.end(), ResampleJoint);
+			}
+		}
+
+		if (a_anim->faceData && a_anim->faceData->duration > 0.0f) {
+			auto& face = *a_anim->faceData;
+			std::vector<float> ratios = MakeTimeline(face.duration, a_frameRate);
+			for (auto& r : ratios) {
+				r = std::clamp(r / face.duration, 0.0f, 1.0f);
+			}
+
+			const auto ResampleFace = [&](ozz::animation::offline::RawFloatTrack& a_track) {
+				ResampleKeys(
+					a_track.keyframes, ratios,
+					[](const auto& k) { return k.ratio; },
+					[](const auto& k) { return k.value; },
+					[](auto& k, float r, float v) {
+						k.interpolation = ozz::animation::offline::RawTrackInterpolation::kLinear;
+						k.ratio = r;
+						k.value = v;
+					});
+			};
+
+			if (a_parallel) {
+				std::for_each(std::execution::par, face.tracks.begin(), face.tracks.end(), ResampleFace);
+			} else {
+				std::for_each(face.tracks.begin(), face.tracks.end(), ResampleFace);
+			}
+		}
+	}
+}
\ No newline at end of file
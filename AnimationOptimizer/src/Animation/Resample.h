@@ -0,0 +1,9 @@
+#pragma once
+#include "Animation/Ozz.h"
+
+namespace Animation
+{
+	//Resamples every multi-key joint & face track onto a uniform timeline at a_frameRate, with a final key landing exactly on the duration.
+	//Single-key (constant) tracks are left as they are.
+	void ResampleAnimation(RawOzzAnimation* a_anim, float a_frameRate, bool a_parallel = true);
+}
\ No newline at end of file
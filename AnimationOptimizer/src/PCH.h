@@ -100,6 +100,7 @@
 
 // winnt
 #include <ShlObj_core.h>
+#include <Psapi.h>
 
 #undef min
 #undef max
@@ -0,0 +1,143 @@
+#include "ExportBenchmark.h"
+#include "GLTFExport.h"
+
+namespace Serialization
+{
+	namespace
+	{
+		constexpr size_t Fanout = 4;
+
+		//Joint i parents joints Fanout*i+1 to Fanout*i+Fanout, which keeps the hierarchy shallow at any joint count.
+		void AddChildren(ozz::animation::offline::RawSkeleton::Joint& parent, size_t idx, size_t jointCount)
+		{
+			for (size_t c = (idx * Fanout) + 1; c <= (idx * Fanout) + Fanout && c < jointCount; c++) {
+				auto& child = parent.children.emplace_back();
+				child.name = std::format("joint_{}", c);
+				child.transform = ozz::math::Transform::identity();
+				child.transform.translation = ozz::math::Float3(0.0f, 0.1f, 0.0f);
+				AddChildren(child, c, jointCount);
+			}
+		}
+
+		ozz::unique_ptr<ozz::animation::Skeleton> MakeSkeleton(size_t jointCount)
+		{
+			ozz::animation::offline::RawSkeleton raw;
+			auto& root = raw.roots.emplace_back();
+			root.name = "joint_0";
+			root.transform = ozz::math::Transform::identity();
+			AddChildren(root, 0, jointCount);
+
+			ozz::animation::offline::SkeletonBuilder builder;
+			return builder(raw);
+		}
+
+		//Animated rotations & translations on a shared timeline, with constant scales, like a typical body clip.
+		ozz::unique_ptr<ozz::animation::offline::RawAnimation> MakeAnimation(const ozz::animation::Skeleton* skeleton, size_t keysPerTrack)
+		{
+			std::mt19937 rng(1234);
+			std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+			auto result = ozz::make_unique<ozz::animation::offline::RawAnimation>();
+			result->duration = 1.0f;
+			result->tracks.resize(skeleton->num_joints());
+			for (auto& t : result->tracks) {
+				for (size_t k = 0; k < keysPerTrack; k++) {
+					const float time = keysPerTrack > 1 ? static_cast<float>(k) / static_cast<float>(keysPerTrack - 1) : 0.0f;
+					const ozz::math::Quaternion q{ dist(rng), dist(rng), dist(rng), dist(rng) + 2.0f };
+					t.rotations.push_back({ time, ozz::math::Normalize(q) });
+					t.translations.push_back({ time, ozz::math::Float3(dist(rng), dist(rng), dist(rng)) });
+				}
+				t.scales.push_back({ 0.0f, ozz::math::Float3::one() });
+			}
+			return result;
+		}
+
+		template <class Func>
+		double MedianMs(size_t iterations, Func&& func)
+		{
+			std::vector<double> times(iterations);
+			for (auto& t : times) {
+				auto start = std::chrono::steady_clock::now();
+				func();
+				t = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			}
+
+			std::sort(times.begin(), times.end());
+			return times[times.size() / 2];
+		}
+
+		//(input, output) accessor pairs in the order the export emits samplers: a shared time accessor, a unique output per
+		//rotation & translation, and one shared output for every constant scale.
+		std::vector<std::pair<size_t, size_t>> MakeSamplerSequence(size_t jointCount)
+		{
+			std::vector<std::pair<size_t, size_t>> result;
+			result.reserve(jointCount * 3);
+			for (size_t i = 0; i < jointCount; i++) {
+				result.emplace_back(0, (i * 2) + 2);
+				result.emplace_back(0, (i * 2) + 3);
+				result.emplace_back(1, 1);
+			}
+			return result;
+		}
+
+		size_t LinearLookup(const std::vector<std::pair<size_t, size_t>>& sequence)
+		{
+			std::vector<std::pair<size_t, size_t>> samplers;
+			for (auto& s : sequence) {
+				if (std::find(samplers.begin(), samplers.end(), s) == samplers.end()) {
+					samplers.push_back(s);
+				}
+			}
+			return samplers.size();
+		}
+
+		size_t HashedLookup(const std::vector<std::pair<size_t, size_t>>& sequence)
+		{
+			std::unordered_map<uint64_t, size_t> index;
+			index.reserve(sequence.size());
+			for (auto& s : sequence) {
+				const uint64_t key = (static_cast<uint64_t>(s.first) << 32) | static_cast<uint64_t>(s.second);
+				index.try_emplace(key, index.size());
+			}
+			return index.size();
+		}
+	}
+
+	std::string ExportBenchmark::Run(size_t jointCount, size_t keysPerTrack, size_t iterations)
+	{
+		jointCount = std::max<size_t>(jointCount, 4);
+		keysPerTrack = std::max<size_t>(keysPerTrack, 2);
+		iterations = std::max<size_t>(iterations, 1);
+
+		std::string result = "{\"runs\":[";
+		const size_t counts[] = { jointCount / 4, jointCount / 2, jointCount };
+		for (size_t c = 0; c < std::size(counts); c++) {
+			const size_t n = counts[c];
+			auto skeleton = MakeSkeleton(n);
+			if (!skeleton)
+				return {};
+
+			auto source = MakeAnimation(skeleton.get(), keysPerTrack);
+			size_t outputSize = 0;
+			const double exportMs = MedianMs(iterations, [&]() {
+				Animation::RawOzzAnimation anim;
+				anim.data = ozz::make_unique<ozz::animation::offline::RawAnimation>(*source);
+				outputSize = GLTFExport::CreateOptimizedAsset(&anim, skeleton.get()).size();
+			});
+
+			//Both lookups return their sampler count so the work can't be optimized away.
+			auto sequence = MakeSamplerSequence(n);
+			size_t samplerCount = 0;
+			const double linearMs = MedianMs(iterations, [&]() { samplerCount = LinearLookup(sequence); });
+			const double hashedMs = MedianMs(iterations, [&]() { samplerCount = HashedLookup(sequence); });
+
+			result += std::format(R"({{"joints":{},"exportMs":{:.3f},"exportMsPerJoint":{:.5f},"outputBytes":{},"samplers":{},"linearLookupMs":{:.3f},"hashedLookupMs":{:.3f}}})",
+				n, exportMs, exportMs / static_cast<double>(n), outputSize, samplerCount, linearMs, hashedMs);
+			if ((c + 1) < std::size(counts)) {
+				result += ",";
+			}
+		}
+		result += "]}";
+		return result;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace Serialization
+{
+	//Times CreateOptimizedAsset on synthetic skeletons at a quarter, half and all of jointCount joints, so the scaling of channel
+	//emission is visible. Alongside each export it times the old linear sampler scan against the hashed sampler index on the
+	//same sampler sequence. Returns the results as JSON, with every time the median of iterations runs in milliseconds.
+	class ExportBenchmark
+	{
+	public:
+		static std::string Run(size_t jointCount, size_t keysPerTrack, size_t iterations);
+	};
+}
\ No newline at end of file
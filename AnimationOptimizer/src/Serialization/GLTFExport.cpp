@@ -1,5 +1,8 @@
 #include "GLTFExport.h"
 #include "Settings/Settings.h"
+#include "Animation/PoseError.h"
+#include "Serialization/Quantization.h"
+#include "Util/Hash.h"
 
 namespace Serialization
 {
@@ -9,6 +12,22 @@ namespace Serialization
 		constexpr size_t Vec3Size = sizeof(float) * 3;
 		constexpr size_t ScalarSize = sizeof(float);
 
+		static_assert(sizeof(ozz::math::Quaternion) == Vec4Size);
+		static_assert(sizeof(ozz::math::Float3) == Vec3Size);
+
+		template <class T>
+		constexpr fastgltf::AccessorType AccessorTypeOf()
+		{
+			if constexpr (std::is_same_v<T, ozz::math::Quaternion>) {
+				return fastgltf::AccessorType::Vec4;
+			} else if constexpr (std::is_same_v<T, ozz::math::Float3>) {
+				return fastgltf::AccessorType::Vec3;
+			} else {
+				static_assert(std::is_same_v<T, float>);
+				return fastgltf::AccessorType::Scalar;
+			}
+		}
+
 		enum BufferType
 		{
 			Rot,
@@ -18,6 +37,239 @@ namespace Serialization
 			Morphs
 		};
 
+		enum ElidedPath : uint8_t
+		{
+			kNone = 0,
+			kRotation = 1 << 0,
+			kTranslation = 1 << 1,
+			kScale = 1 << 2
+		};
+
+		template <class Key>
+		bool IsConstant(const ozz::vector<Key>& keys)
+		{
+			return std::all_of(keys.begin(), keys.end(), [&](const Key& k) { return k.value == keys.front().value; });
+		}
+
+		//Moves every constant joint track into its node's TRS and returns, per joint, which paths no longer need a channel.
+		//The importer fills channel-less paths from the node transform, so the track comes back unchanged.
+		//A track is kept if dropping it would shorten the animation, since duration is implied by the last key.
+		std::vector<uint8_t> ElideConstantTracks(const ozz::animation::offline::RawAnimation& anim, fastgltf::Asset& asset)
+		{
+			std::vector<uint8_t> elided(anim.tracks.size(), ElidedPath::kNone);
+
+			float endTime = 0.0f;
+			float keptEndTime = 0.0f;
+			const auto Consider = [&](uint8_t& mask, ElidedPath path, bool constant, float lastTime) {
+				endTime = std::max(endTime, lastTime);
+				if (constant) {
+					mask |= path;
+				} else {
+					keptEndTime = std::max(keptEndTime, lastTime);
+				}
+			};
+
+			for (size_t i = 0; i < anim.tracks.size(); i++) {
+				auto& trck = anim.tracks[i];
+				Consider(elided[i], ElidedPath::kRotation, IsConstant(trck.rotations), trck.rotations.back().time);
+				Consider(elided[i], ElidedPath::kTranslation, IsConstant(trck.translations), trck.translations.back().time);
+				Consider(elided[i], ElidedPath::kScale, IsConstant(trck.scales), trck.scales.back().time);
+			}
+
+			//Keep one track reaching the end, so the animation's duration survives.
+			if (keptEndTime < endTime) {
+				for (size_t i = 0; i < anim.tracks.size() && keptEndTime < endTime; i++) {
+					auto& trck = anim.tracks[i];
+					if ((elided[i] & ElidedPath::kRotation) && trck.rotations.back().time >= endTime) {
+						elided[i] &= ~ElidedPath::kRotation;
+						keptEndTime = endTime;
+					} else if ((elided[i] & ElidedPath::kTranslation) && trck.translations.back().time >= endTime) {
+						elided[i] &= ~ElidedPath::kTranslation;
+						keptEndTime = endTime;
+					} else if ((elided[i] & ElidedPath::kScale) && trck.scales.back().time >= endTime) {
+						elided[i] &= ~ElidedPath::kScale;
+						keptEndTime = endTime;
+					}
+				}
+			}
+
+			for (size_t i = 0; i < anim.tracks.size(); i++) {
+				auto& trck = anim.tracks[i];
+				auto& trs = std::get<fastgltf::TRS>(asset.nodes[i].transform);
+				if (elided[i] & ElidedPath::kRotation) {
+					auto& r = trck.rotations.front().value;
+					trs.rotation = { r.x, r.y, r.z, r.w };
+				}
+				if (elided[i] & ElidedPath::kTranslation) {
+					auto& t = trck.translations.front().value;
+					trs.translation = { t.x, t.y, t.z };
+				}
+				if (elided[i] & ElidedPath::kScale) {
+					auto& sc = trck.scales.front().value;
+					trs.scale = { sc.x, sc.y, sc.z };
+				}
+			}
+
+			return elided;
+		}
+
+		//Skeleton units are glTF meters, error budgets are given in centimeters.
+		constexpr float UnitsToCm = 100.0f;
+
+		//Offset of the points measured around each joint, roughly how far skinned vertices sit from their bones.
+		constexpr float ErrorPointDistance = 0.1f;
+
+		ozz::unique_ptr<ozz::animation::offline::RawAnimation> OptimizeWithTolerance(const ozz::animation::offline::RawAnimation& raw, const ozz::animation::Skeleton* skeleton, float tolerance, const Animation::JointOverrides* overrides)
+		{
+			auto result = ozz::make_unique<ozz::animation::offline::RawAnimation>();
+			ozz::animation::offline::AnimationOptimizer optimizer;
+			optimizer.setting.distance = 1.0f;
+			optimizer.setting.tolerance = tolerance;
+			if (overrides != nullptr) {
+				overrides->Apply(skeleton, optimizer);
+			}
+			if (!optimizer(raw, *skeleton, result.get()))
+				return nullptr;
+
+			return result;
+		}
+
+		//Binary-searches the optimizer tolerance, on a log scale, for the most aggressive setting whose measured max
+		//model-space error stays within targetCm. Returns nullptr if the error can't be measured, so the caller falls back
+		//to the fixed tolerance. If even a lossless pass is over budget, that pass is returned and the report says so.
+		ozz::unique_ptr<ozz::animation::offline::RawAnimation> OptimizeToErrorBudget(const ozz::animation::offline::RawAnimation& raw, const ozz::animation::Skeleton* skeleton, std::span<const int16_t> parents, float targetCm, const Animation::JointOverrides* overrides, GLTFExport::ExportStats* stats)
+		{
+			constexpr float minTolerance = 1e-7f;
+			constexpr float maxTolerance = 1e-1f;
+			constexpr int iterations = 12;
+
+			Animation::PoseErrorMeasure measure(skeleton, parents, Settings::GetErrorSampleCount(), ErrorPointDistance);
+			if (!measure.SetReference(raw))
+				return nullptr;
+
+			const float target = targetCm / UnitsToCm;
+			ozz::unique_ptr<ozz::animation::offline::RawAnimation> best;
+			Animation::PoseError bestError;
+			float bestTolerance = 0.0f;
+
+			const auto Try = [&](float tolerance) {
+				auto candidate = OptimizeWithTolerance(raw, skeleton, tolerance, overrides);
+				if (!candidate)
+					return false;
+
+				auto err = measure.Measure(*candidate);
+				if (!err.has_value() || err->maxError > target)
+					return false;
+
+				best = std::move(candidate);
+				bestError = err.value();
+				bestTolerance = tolerance;
+				return true;
+			};
+
+			if (!Try(maxTolerance)) {
+				float lo = minTolerance;
+				float hi = maxTolerance;
+				if (Try(lo)) {
+					for (int i = 0; i < iterations; i++) {
+						const float mid = std::sqrt(lo * hi);
+						if (Try(mid)) {
+							lo = mid;
+						} else {
+							hi = mid;
+						}
+					}
+				}
+			}
+
+			bool withinBudget = (best != nullptr);
+			if (!best) {
+				best = OptimizeWithTolerance(raw, skeleton, 0.0f, overrides);
+				if (!best)
+					return nullptr;
+
+				auto err = measure.Measure(*best);
+				if (!err.has_value())
+					return nullptr;
+
+				bestError = err.value();
+			}
+
+			if (stats != nullptr) {
+				stats->errorMeasured = true;
+				stats->withinBudget = withinBudget;
+				stats->tolerance = bestTolerance;
+				stats->maxErrorCm = bestError.maxError * UnitsToCm;
+				stats->meanErrorCm = bestError.meanError * UnitsToCm;
+			}
+			return best;
+		}
+
+		//Reduces each multi-key morph track on its own. Tracks ozz can't optimize are kept as they are.
+		void OptimizeMorphTracks(Animation::RawOzzFaceAnimation& face, float tolerance)
+		{
+			ozz::animation::offline::TrackOptimizer optimizer;
+			optimizer.tolerance = tolerance;
+			for (auto& t : face.tracks) {
+				if (t.keyframes.size() < 3)
+					continue;
+
+				ozz::animation::offline::RawFloatTrack optimized;
+				if (optimizer(t, &optimized)) {
+					t = std::move(optimized);
+				}
+			}
+		}
+
+		//glTF drives all weights of a mesh through one sampler, so the reduced tracks are written on the sorted union
+		//of their key ratios rather than on any single track's timeline.
+		std::vector<float> MakeMorphTimeline(const std::vector<ozz::animation::offline::RawFloatTrack*>& tracks)
+		{
+			std::vector<float> result;
+			for (auto t : tracks) {
+				for (auto& k : t->keyframes) {
+					result.push_back(k.ratio);
+				}
+			}
+
+			std::sort(result.begin(), result.end());
+			result.erase(std::unique(result.begin(), result.end()), result.end());
+			if (result.empty()) {
+				result.push_back(0.0f);
+			}
+			return result;
+		}
+
+		//Samples track at each of the ascending ratios with a forward-only cursor, writing every stride'th value of out.
+		void SampleMorphTrack(const ozz::animation::offline::RawFloatTrack& track, const std::vector<float>& ratios, float* out, size_t stride)
+		{
+			auto& kfs = track.keyframes;
+			if (kfs.empty()) {
+				for (size_t i = 0; i < ratios.size(); i++, out += stride) {
+					*out = 0.0f;
+				}
+				return;
+			}
+
+			size_t cursor = 0;
+			for (size_t i = 0; i < ratios.size(); i++, out += stride) {
+				const float r = ratios[i];
+				while (cursor + 1 < kfs.size() && kfs[cursor + 1].ratio <= r) {
+					cursor++;
+				}
+
+				auto& from = kfs[cursor];
+				if (cursor + 1 >= kfs.size() || r <= from.ratio || from.interpolation == ozz::animation::offline::RawTrackInterpolation::kStep) {
+					*out = from.value;
+					continue;
+				}
+
+				auto& to = kfs[cursor + 1];
+				const float alpha = (r - from.ratio) / (to.ratio - from.ratio);
+				*out = from.value + (to.value - from.value) * alpha;
+			}
+		}
+
 		struct ExportUtil
 		{
 			void Init(const ozz::animation::Skeleton* skeleton)
@@ -37,35 +289,41 @@ namespace Serialization
 				}
 			}
 
-			size_t MakeBView(size_t bufferIdx, size_t length)
+			//Reserves arena space up front so long clips don't pay for repeated regrowth.
+			void Reserve(size_t length)
 			{
-				auto& bv = asset->bufferViews.emplace_back();
-				bv.bufferIndex = bufferIdx;
-				bv.byteLength = length;
-				bv.byteOffset = 0;
-				return (asset->bufferViews.size() - 1);
+				arena.reserve(length);
 			}
 
-			fastgltf::sources::Vector& MakeBuffer(size_t length)
+			//Appends an aligned block of count Ts, filled in place by fill(T*), then dedupes it.
+			//Returns the byte offset of the data, which may be an earlier identical block.
+			template <class T, class Fill>
+			size_t EmplaceBlock(size_t count, BufferType bufType, Fill&& fill)
 			{
-				auto& buf = asset->buffers.emplace_back();
-				buf.data.emplace<fastgltf::sources::Vector>();
-				auto& bVec = std::get<fastgltf::sources::Vector>(buf.data);
-				bVec.mimeType = fastgltf::MimeType::GltfBuffer;
-				bVec.bytes.resize(length);
-				return bVec;
+				const size_t offset = AlignUp(arena.size());
+				const size_t length = sizeof(T) * count;
+				arena.resize(offset + length);
+				fill(reinterpret_cast<T*>(arena.data() + offset));
+				return DedupeLastBlock(bufType, offset, length);
 			}
 
-			size_t WriteBuffer(size_t unitSize, size_t length, BufferType bufType, const std::function<void*(size_t)>& getFunc)
+			//Copies count elements of T, stride bytes apart starting at src, to the end of the arena.
+			//Packed sources are a single memcpy, strided ones a fixed-size copy per element.
+			template <class T>
+			size_t WriteBuffer(const std::byte* src, size_t stride, size_t count, BufferType bufType)
 			{
-				auto& buf = MakeBuffer(unitSize * length);
-				for (size_t i = 0; i < length; i++) {
-					memcpy(&buf.bytes[i * unitSize], getFunc(i), unitSize);
-				}
-				return DedupeLastBuffer(bufType, buf);
+				return EmplaceBlock<uint8_t>(sizeof(T) * count, bufType, [&](uint8_t* dst) {
+					if (stride == sizeof(T)) {
+						std::memcpy(dst, src, sizeof(T) * count);
+					} else {
+						for (size_t i = 0; i < count; i++) {
+							std::memcpy(dst + (i * sizeof(T)), src + (i * stride), sizeof(T));
+						}
+					}
+				});
 			}
 
-			size_t MakeAccessor(double min, double max, fastgltf::AccessorType type, size_t count, size_t bufferView)
+			size_t MakeAccessor(double min, double max, fastgltf::AccessorType type, size_t count, size_t byteOffset)
 			{
 				auto& acc = asset->accessors.emplace_back();
 				acc.min.emplace<std::pmr::vector<double>>(1, min);
@@ -73,100 +331,182 @@ namespace Serialization
 				acc.type = type;
 				acc.count = count;
 				acc.componentType = fastgltf::ComponentType::Float;
-				acc.bufferViewIndex = bufferView;
+				acc.bufferViewIndex = 0;
+				acc.byteOffset = byteOffset;
 				return (asset->accessors.size() - 1);
 			}
 
-			size_t WriteAccessor(double min, double max, fastgltf::AccessorType type, size_t length, BufferType bufType, const std::function<void*(size_t)>& getFunc)
+			template <class T>
+			size_t WriteAccessor(double min, double max, const std::byte* src, size_t stride, size_t count, BufferType bufType)
 			{
-				size_t unitSize = 0;
-				switch (type) {
-				case fastgltf::AccessorType::Scalar:
-					unitSize = ScalarSize;
-					break;
-				case fastgltf::AccessorType::Vec3:
-					unitSize = Vec3Size;
-					break;
-				case fastgltf::AccessorType::Vec4:
-					unitSize = Vec4Size;
-					break;
-				}
-
-				auto bufIdx = WriteBuffer(unitSize, length, bufType, getFunc);
-				bufferMap[bufType].insert(bufIdx);
+				auto offset = WriteBuffer<T>(src, stride, count, bufType);
 
 				//Prevent accessor duplication.
-				if (auto iter = bufferAccMap.find(bufIdx); iter != bufferAccMap.end()) {
+				if (auto iter = bufferAccMap.find(offset); iter != bufferAccMap.end()) {
 					return iter->second;
 				}
 
-				auto bvIdx = MakeBView(bufIdx, unitSize * length);
-				auto accIdx = MakeAccessor(min, max, type, length, bvIdx);
-				bufferAccMap[bufIdx] = accIdx;
+				auto accIdx = MakeAccessor(min, max, AccessorTypeOf<T>(), count, offset);
+				bufferAccMap[offset] = accIdx;
 				return accIdx;
 			}
 
-			size_t DedupeLastBuffer(BufferType bufType, fastgltf::sources::Vector& cmp)
+			//Writes one member of each key, e.g. &RotationKey::value.
+			template <class Key, class T>
+			size_t WriteAccessor(double min, double max, const ozz::vector<Key>& keys, T Key::*member, BufferType bufType)
+			{
+				const std::byte* src = keys.empty() ? nullptr : reinterpret_cast<const std::byte*>(&(keys.data()->*member));
+				return WriteAccessor<T>(min, max, src, sizeof(Key), keys.size(), bufType);
+			}
+
+			template <class T>
+			size_t WriteAccessor(double min, double max, const std::vector<T>& values, BufferType bufType)
+			{
+				return WriteAccessor<T>(min, max, reinterpret_cast<const std::byte*>(values.data()), sizeof(T), values.size(), bufType);
+			}
+
+			//Normalized integer accessor, only used for rotation outputs.
+			size_t MakeQuantizedAccessor(size_t offset, fastgltf::AccessorType type, fastgltf::ComponentType componentType, size_t count)
 			{
-				auto iter = bufferMap.find(bufType);
-				if (iter == bufferMap.end()) {
-					return (asset->buffers.size() - 1);
+				if (auto iter = quantAccMap.find(offset); iter != quantAccMap.end()) {
+					return iter->second;
 				}
 
-				for (auto& idx : iter->second) {
-					auto& vec = std::get<fastgltf::sources::Vector>(asset->buffers[idx].data);
-					if (vec.bytes.size() != cmp.bytes.size())
-						continue;
+				auto& acc = asset->accessors.emplace_back();
+				acc.type = type;
+				acc.count = count;
+				acc.componentType = componentType;
+				acc.normalized = true;
+				acc.bufferViewIndex = 0;
+				acc.byteOffset = offset;
+
+				const size_t accIdx = asset->accessors.size() - 1;
+				quantAccMap.emplace(offset, accIdx);
+				return accIdx;
+			}
+
+			//Sampler inputs stay float: core glTF requires it, and ozz needs strictly increasing times.
+			template <class Key>
+			size_t WriteTimes(const ozz::vector<Key>& keys)
+			{
+				return WriteAccessor(keys.front().time, keys.back().time, keys, &Key::time, BufferType::Time);
+			}
 
-					if (memcmp(vec.bytes.data(), cmp.bytes.data(), cmp.bytes.size()) == 0) {
-						asset->buffers.pop_back();
-						return idx;
+			//Quaternions as snorm16 on all four components, which core glTF allows for rotation outputs.
+			size_t WriteRotations(const ozz::vector<ozz::animation::offline::RawAnimation::RotationKey>& keys)
+			{
+				if (!quantize)
+					return WriteAccessor(0.0f, 0.0f, keys, &ozz::animation::offline::RawAnimation::RotationKey::value, BufferType::Rot);
+
+				auto offset = EmplaceBlock<int16_t>(keys.size() * 4, BufferType::Rot, [&](int16_t* dst) {
+					for (auto& k : keys) {
+						*dst++ = Quantization::EncodeSnorm16(k.value.x);
+						*dst++ = Quantization::EncodeSnorm16(k.value.y);
+						*dst++ = Quantization::EncodeSnorm16(k.value.z);
+						*dst++ = Quantization::EncodeSnorm16(k.value.w);
 					}
-				}
-				return (asset->buffers.size() - 1);
+				});
+				return MakeQuantizedAccessor(offset, fastgltf::AccessorType::Vec4, fastgltf::ComponentType::Short, keys.size());
 			}
 
-			void CombineBuffers()
+			//Looks the block just written at offset up by (type, length, content hash), confirming candidates with memcmp.
+			//A duplicate is dropped by truncating the arena back to where it started.
+			size_t DedupeLastBlock(BufferType bufType, size_t offset, size_t length)
 			{
-				std::vector<size_t> idxPosMap;
-				idxPosMap.reserve(asset->buffers.size());
+				const uint8_t* block = arena.data() + offset;
+				const uint64_t key = Util::Hash::Combine(Util::Hash::Hash64(block, length, bufType), length);
 
-				std::vector<fastgltf::Buffer> finalVec;
-				auto& finalBuf = finalVec.emplace_back();
-				finalBuf.data.emplace<fastgltf::sources::Vector>();
-				auto& bVec = std::get<fastgltf::sources::Vector>(finalBuf.data);
-				bVec.mimeType = fastgltf::MimeType::OctetStream;
+				auto range = blockIndex.equal_range(key);
+				for (auto iter = range.first; iter != range.second; iter++) {
+					auto& [prevOffset, prevLength] = iter->second;
+					if (prevLength != length)
+						continue;
 
-				for (auto& b : asset->buffers) {
-					idxPosMap.push_back(bVec.bytes.empty() ? 0 : bVec.bytes.size());
-					auto& curVec = std::get<fastgltf::sources::Vector>(b.data);
-					bVec.bytes.insert(bVec.bytes.end(), curVec.bytes.begin(), curVec.bytes.end());
+					if (memcmp(arena.data() + prevOffset, block, length) == 0) {
+						stats.dedupeHits++;
+						stats.dedupeBytesSaved += length;
+						arena.resize(offset);
+						return prevOffset;
+					}
 				}
 
-				size_t bufSize = bVec.bytes.size();
-				finalBuf.byteLength = bufSize;
-				asset->buffers = std::move(finalVec);
+				blockIndex.emplace(key, std::make_pair(offset, length));
+				CountBytes(bufType, length);
+				return offset;
+			}
 
-				for (auto& acc : asset->accessors) {
-					acc.byteOffset = idxPosMap[acc.bufferViewIndex.value()];
-					acc.bufferViewIndex = 0;
+			void CountBytes(BufferType bufType, size_t length)
+			{
+				auto& bytes = stats.accessorBytes;
+				switch (bufType) {
+				case Rot:
+					bytes.rotations += length;
+					break;
+				case Time:
+					bytes.times += length;
+					break;
+				case Trans:
+					bytes.translations += length;
+					break;
+				case Scale:
+					bytes.scales += length;
+					break;
+				case Morphs:
+					bytes.morphs += length;
+					break;
 				}
+			}
+
+			//Hands the arena to the asset as its only buffer, with a single view covering all of it.
+			void Finalize()
+			{
+				const size_t bufSize = arena.size();
+
+				auto& buf = asset->buffers.emplace_back();
+				buf.byteLength = bufSize;
+				buf.data.emplace<fastgltf::sources::Vector>();
+				auto& bVec = std::get<fastgltf::sources::Vector>(buf.data);
+				bVec.mimeType = fastgltf::MimeType::OctetStream;
+				bVec.bytes = std::move(arena);
 
-				asset->bufferViews = std::vector<fastgltf::BufferView>();
-				auto& finalBV = asset->bufferViews.emplace_back();
-				finalBV.bufferIndex = 0;
-				finalBV.byteLength = bufSize;
-				finalBV.byteOffset = 0;
+				auto& bv = asset->bufferViews.emplace_back();
+				bv.bufferIndex = 0;
+				bv.byteLength = bufSize;
+				bv.byteOffset = 0;
 			}
 
+			//glTF requires accessor offsets to be a multiple of the component size.
+			static size_t AlignUp(size_t offset)
+			{
+				constexpr size_t alignment = ScalarSize;
+				return (offset + alignment - 1) & ~(alignment - 1);
+			}
+
+			std::vector<uint8_t> arena;
 			std::map<size_t, size_t> bufferAccMap;
-			std::map<BufferType, std::set<size_t>> bufferMap;
+			std::map<size_t, size_t> quantAccMap;
+			bool quantize = false;
+			std::unordered_multimap<uint64_t, std::pair<size_t, size_t>> blockIndex;
 			std::unique_ptr<fastgltf::Asset> asset;
+			GLTFExport::ExportStats stats;
 		};
 	}
 
-	std::vector<std::byte> GLTFExport::CreateOptimizedAsset(Animation::RawOzzAnimation* anim, const ozz::animation::Skeleton* skeleton, uint8_t level)
+	std::vector<std::byte> GLTFExport::CreateOptimizedAsset(Animation::RawOzzAnimation* anim, const ozz::animation::Skeleton* skeleton, uint8_t level, const Animation::JointOverrides* overrides, ExportStats* stats, std::span<const int16_t> parents)
 	{
+		ExportStats report;
+		for (auto& trck : anim->data->tracks) {
+			report.inputKeys.rotations += trck.rotations.size();
+			report.inputKeys.translations += trck.translations.size();
+			report.inputKeys.scales += trck.scales.size();
+		}
+		if (anim->faceData != nullptr) {
+			for (auto& t : anim->faceData->tracks) {
+				report.inputKeys.morphs += t.keyframes.size();
+			}
+		}
+
+		auto optimizeStart = std::chrono::steady_clock::now();
 		if (level > 0) {
 			float toleranceLevel = 1e-5;
 
@@ -182,100 +522,103 @@ namespace Serialization
 				break;
 			}
 
-			ozz::unique_ptr<ozz::animation::offline::RawAnimation> tempAnim = ozz::make_unique<ozz::animation::offline::RawAnimation>();
-			ozz::animation::offline::AnimationOptimizer optimizer;
-			optimizer.setting.distance = 1.0f;
-			optimizer.setting.tolerance = toleranceLevel;
-			optimizer(*anim->data, *skeleton, tempAnim.get());
-			anim->data = std::move(tempAnim);
+			ozz::unique_ptr<ozz::animation::offline::RawAnimation> optimized;
+			if (float target = Settings::GetTargetError(); target > 0.0f) {
+				optimized = OptimizeToErrorBudget(*anim->data, skeleton, parents, target, overrides, &report);
+			}
+
+			if (!optimized) {
+				optimized = OptimizeWithTolerance(*anim->data, skeleton, toleranceLevel, overrides);
+			}
+
+			if (optimized) {
+				anim->data = std::move(optimized);
+			}
+
+			if (anim->faceData != nullptr) {
+				OptimizeMorphTracks(*anim->faceData, level == 1 ? 0.0f : Settings::GetMorphTolerance());
+			}
 		}
 
+		auto exportStart = std::chrono::steady_clock::now();
+		report.optimizeMs = std::chrono::duration<double, std::milli>(exportStart - optimizeStart).count();
+
 		ExportUtil util;
 		auto& asset = util.asset;
 		util.Init(skeleton);
+		util.quantize = Settings::GetQuantizeRotations();
+
+		std::vector<uint8_t> elided(anim->data->tracks.size(), ElidedPath::kNone);
+		if (Settings::GetElideConstantTracks()) {
+			elided = ElideConstantTracks(*anim->data, *asset);
+		}
+
+		//Upper bound before dedupe: a time and a value per key.
+		size_t expectedSize = 0;
+		for (auto& trck : anim->data->tracks) {
+			expectedSize += trck.rotations.size() * (ScalarSize + Vec4Size);
+			expectedSize += trck.translations.size() * (ScalarSize + Vec3Size);
+			expectedSize += trck.scales.size() * (ScalarSize + Vec3Size);
+		}
+		util.Reserve(expectedSize);
 
 		auto& assetAnim = asset->animations.emplace_back();
 		assetAnim.name = "Animation";
 
+		//Samplers are keyed by their (input, output) accessor pair. Accessor counts stay far below 2^32.
+		std::unordered_map<uint64_t, size_t> samplerIndex;
+		samplerIndex.reserve(anim->data->tracks.size() * 3);
 		const auto DedupeSampler = [&](const fastgltf::AnimationSampler& smplr) -> size_t {
-			for (size_t i = 0; i < (assetAnim.samplers.size() - 1); i++) {
-				auto& s = assetAnim.samplers[i];
-				if (s.inputAccessor == smplr.inputAccessor && s.outputAccessor == smplr.outputAccessor) {
-					assetAnim.samplers.pop_back();
-					return i;
-				}
+			const uint64_t key = (static_cast<uint64_t>(smplr.inputAccessor) << 32) | static_cast<uint64_t>(smplr.outputAccessor);
+			auto [iter, inserted] = samplerIndex.try_emplace(key, assetAnim.samplers.size() - 1);
+			if (!inserted) {
+				assetAnim.samplers.pop_back();
+				report.samplersDeduplicated++;
 			}
-			return (assetAnim.samplers.size() - 1);
+			return iter->second;
 		};
 
 		for (size_t i = 0; i < anim->data->tracks.size(); i++) {
 			auto& trck = anim->data->tracks[i];
 
-			auto& rotSmplr = assetAnim.samplers.emplace_back();
-			rotSmplr.interpolation = fastgltf::AnimationInterpolation::Linear;
-			rotSmplr.inputAccessor = util.WriteAccessor(
-				trck.rotations.front().time,
-				trck.rotations.back().time,
-				fastgltf::AccessorType::Scalar,
-				trck.rotations.size(),
-				BufferType::Time,
-				[&](size_t i) { return &trck.rotations[i].time; });
-			rotSmplr.outputAccessor = util.WriteAccessor(
-				0.0f,
-				0.0f,
-				fastgltf::AccessorType::Vec4,
-				trck.rotations.size(),
-				BufferType::Rot,
-				[&](size_t i) { return &trck.rotations[i].value; });
-
-			auto& rotChnl = assetAnim.channels.emplace_back();
-			rotChnl.nodeIndex = i;
-			rotChnl.path = fastgltf::AnimationPath::Rotation;
-			rotChnl.samplerIndex = DedupeSampler(rotSmplr);
-
-			auto& transSmplr = assetAnim.samplers.emplace_back();
-			transSmplr.interpolation = fastgltf::AnimationInterpolation::Linear;
-			transSmplr.inputAccessor = util.WriteAccessor(
-				trck.translations.front().time,
-				trck.translations.back().time,
-				fastgltf::AccessorType::Scalar,
-				trck.translations.size(),
-				BufferType::Time,
-				[&](size_t i) { return &trck.translations[i].time; });
-			transSmplr.outputAccessor = util.WriteAccessor(
-				0.0f,
-				0.0f,
-				fastgltf::AccessorType::Vec3,
-				trck.translations.size(),
-				BufferType::Trans,
-				[&](size_t i) { return &trck.translations[i].value; });
-
-			auto& transChnl = assetAnim.channels.emplace_back();
-			transChnl.nodeIndex = i;
-			transChnl.path = fastgltf::AnimationPath::Translation;
-			transChnl.samplerIndex = DedupeSampler(transSmplr);
-
-			auto& scaleSmplr = assetAnim.samplers.emplace_back();
-			scaleSmplr.interpolation = fastgltf::AnimationInterpolation::Linear;
-			scaleSmplr.inputAccessor = util.WriteAccessor(
-				trck.scales.front().time,
-				trck.scales.back().time,
-				fastgltf::AccessorType::Scalar,
-				trck.scales.size(),
-				BufferType::Time,
-				[&](size_t i) { return &trck.scales[i].time; });
-			scaleSmplr.outputAccessor = util.WriteAccessor(
-				0.0f,
-				0.0f,
-				fastgltf::AccessorType::Vec3,
-				trck.scales.size(),
-				BufferType::Scale,
-				[&](size_t i) { return &trck.scales[i].value; });
-
-			auto& scaleChnl = assetAnim.channels.emplace_back();
-			scaleChnl.nodeIndex = i;
-			scaleChnl.path = fastgltf::AnimationPath::Scale;
-			scaleChnl.samplerIndex = DedupeSampler(scaleSmplr);
+			if (!(elided[i] & ElidedPath::kRotation)) {
+				auto& rotSmplr = assetAnim.samplers.emplace_back();
+				rotSmplr.interpolation = fastgltf::AnimationInterpolation::Linear;
+				rotSmplr.inputAccessor = util.WriteTimes(trck.rotations);
+				rotSmplr.outputAccessor = util.WriteRotations(trck.rotations);
+				report.outputKeys.rotations += trck.rotations.size();
+
+				auto& rotChnl = assetAnim.channels.emplace_back();
+				rotChnl.nodeIndex = i;
+				rotChnl.path = fastgltf::AnimationPath::Rotation;
+				rotChnl.samplerIndex = DedupeSampler(rotSmplr);
+			}
+
+			if (!(elided[i] & ElidedPath::kTranslation)) {
+				auto& transSmplr = assetAnim.samplers.emplace_back();
+				transSmplr.interpolation = fastgltf::AnimationInterpolation::Linear;
+				transSmplr.inputAccessor = util.WriteTimes(trck.translations);
+				transSmplr.outputAccessor = util.WriteAccessor(0.0f, 0.0f, trck.translations, &ozz::animation::offline::RawAnimation::TranslationKey::value, BufferType::Trans);
+				report.outputKeys.translations += trck.translations.size();
+
+				auto& transChnl = assetAnim.channels.emplace_back();
+				transChnl.nodeIndex = i;
+				transChnl.path = fastgltf::AnimationPath::Translation;
+				transChnl.samplerIndex = DedupeSampler(transSmplr);
+			}
+
+			if (!(elided[i] & ElidedPath::kScale)) {
+				auto& scaleSmplr = assetAnim.samplers.emplace_back();
+				scaleSmplr.interpolation = fastgltf::AnimationInterpolation::Linear;
+				scaleSmplr.inputAccessor = util.WriteTimes(trck.scales);
+				scaleSmplr.outputAccessor = util.WriteAccessor(0.0f, 0.0f, trck.scales, &ozz::animation::offline::RawAnimation::ScaleKey::value, BufferType::Scale);
+				report.outputKeys.scales += trck.scales.size();
+
+				auto& scaleChnl = assetAnim.channels.emplace_back();
+				scaleChnl.nodeIndex = i;
+				scaleChnl.path = fastgltf::AnimationPath::Scale;
+				scaleChnl.samplerIndex = DedupeSampler(scaleSmplr);
+			}
 		}
 
 		std::vector<std::string> morphTargets = Settings::GetFaceMorphs();
@@ -295,6 +638,11 @@ namespace Serialization
 				trackIter++;
 			}
 
+			//Counted per track like the input, the shared timeline below resamples every track onto the union of their keys.
+			for (auto t : tracksView) {
+				report.outputKeys.morphs += t->keyframes.size();
+			}
+
 			if (!tracksView.empty()) {
 				hasFaceAnim = true;
 			}
@@ -312,14 +660,11 @@ namespace Serialization
 			a.first = "POSITION";
 			a.second = 0;
 
-			size_t timeSize = 1;
-			ozz::animation::offline::RawFloatTrack* timeTrack = tracksView[0];
-			for (auto& t : tracksView) {
-				if (t->keyframes.size() > 1) {
-					timeSize = t->keyframes.size();
-					timeTrack = t;
-					break;
-				}
+			const std::vector<float> ratios = MakeMorphTimeline(tracksView);
+			std::vector<float> times;
+			times.reserve(ratios.size());
+			for (auto r : ratios) {
+				times.push_back(r * anim->faceData->duration);
 			}
 
 			auto& smplr = assetAnim.samplers.emplace_back();
@@ -327,32 +672,20 @@ namespace Serialization
 			smplr.inputAccessor = util.WriteAccessor(
 				0.0f,
 				anim->faceData->duration,
-				fastgltf::AccessorType::Scalar,
-				timeSize,
-				BufferType::Time,
-				[&](size_t i) {
-					auto& r = timeTrack->keyframes[i].ratio;
-					r *= anim->faceData->duration;
-					return &r;
-				});
-
-			std::vector<float> combinedWeights;
-			combinedWeights.reserve(tracksView.size() * timeSize);
+				times,
+				BufferType::Time);
 
-			for (size_t i = 0; i < timeSize; i++) {
-				for (size_t j = 0; j < tracksView.size(); j++) {
-					auto& kfs = tracksView[j]->keyframes;
-					combinedWeights.push_back(i >= kfs.size() ? kfs.back().value : kfs[i].value);
-				}
+			//Interleaved per time: every target's weight at times[0], then at times[1], and so on.
+			std::vector<float> combinedWeights(tracksView.size() * ratios.size());
+			for (size_t j = 0; j < tracksView.size(); j++) {
+				SampleMorphTrack(*tracksView[j], ratios, combinedWeights.data() + j, tracksView.size());
 			}
 
 			smplr.outputAccessor = util.WriteAccessor(
 				0.0f,
 				0.0f,
-				fastgltf::AccessorType::Scalar,
-				combinedWeights.size(),
-				BufferType::Morphs,
-				[&](size_t i) { return &combinedWeights[i]; });
+				combinedWeights,
+				BufferType::Morphs);
 
 			auto& chnl = assetAnim.channels.emplace_back();
 			chnl.nodeIndex = (asset->nodes.size() - 1);
@@ -360,7 +693,7 @@ namespace Serialization
 			chnl.samplerIndex = (assetAnim.samplers.size() - 1);
 		}
 
-		util.CombineBuffers();
+		util.Finalize();
 		fastgltf::Exporter exp;
 		exp.setUserPointer(&morphTargets);
 		exp.setExtrasWriteCallback([](std::size_t objectIndex, fastgltf::Category objectType, void* userPointer) -> std::optional<std::string> {
@@ -384,6 +717,34 @@ namespace Serialization
 			return {};
 		}
 
+		if (stats != nullptr) {
+			report.accessorBytes = util.stats.accessorBytes;
+			report.dedupeHits = util.stats.dedupeHits;
+			report.dedupeBytesSaved = util.stats.dedupeBytesSaved;
+			report.exportMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - exportStart).count();
+			*stats = report;
+		}
+
 		return std::move(result.get().output);
 	}
+
+	std::string GLTFExport::ExportStats::ToJson() const
+	{
+		const auto Keys = [](const KeyCounts& k) {
+			return std::format(R"({{"rotations":{},"translations":{},"scales":{},"morphs":{}}})", k.rotations, k.translations, k.scales, k.morphs);
+		};
+
+		std::string result = "{";
+		result += std::format(R"("inputKeys":{},"outputKeys":{},)", Keys(inputKeys), Keys(outputKeys));
+		result += std::format(R"("accessorBytes":{{"rotations":{},"translations":{},"scales":{},"times":{},"morphs":{}}},)",
+			accessorBytes.rotations, accessorBytes.translations, accessorBytes.scales, accessorBytes.times, accessorBytes.morphs);
+		result += std::format(R"("dedupe":{{"buffers":{},"bytesSaved":{},"samplers":{}}},)", dedupeHits, dedupeBytesSaved, samplersDeduplicated);
+		if (errorMeasured) {
+			result += std::format(R"("error":{{"withinBudget":{},"tolerance":{},"maxCm":{},"meanCm":{}}},)", withinBudget, tolerance, maxErrorCm, meanErrorCm);
+		}
+		result += std::format(R"("timeMs":{{"import":{:.3f},"optimize":{:.3f},"export":{:.3f}}},)", importMs, optimizeMs, exportMs);
+		result += std::format(R"("hostPeakWorkingSetBytes":{})", hostPeakWorkingSetBytes);
+		result += "}";
+		return result;
+	}
 }
\ No newline at end of file
@@ -1,11 +1,58 @@
 #pragma once
 #include "Animation/Ozz.h"
+#include "Animation/JointOverrides.h"
 
 namespace Serialization
 {
 	class GLTFExport
 	{
 	public:
-		static std::vector<std::byte> CreateOptimizedAsset(Animation::RawOzzAnimation* anim, const ozz::animation::Skeleton* skeleton, uint8_t level = 0);
+		struct ExportStats
+		{
+			struct KeyCounts
+			{
+				size_t rotations = 0;
+				size_t translations = 0;
+				size_t scales = 0;
+				size_t morphs = 0;
+			};
+
+			struct ByteCounts
+			{
+				size_t rotations = 0;
+				size_t translations = 0;
+				size_t scales = 0;
+				size_t times = 0;
+				size_t morphs = 0;
+			};
+
+			KeyCounts inputKeys;
+			KeyCounts outputKeys;
+			//Bytes stored per accessor category, after deduplication.
+			ByteCounts accessorBytes;
+
+			size_t dedupeHits = 0;
+			size_t dedupeBytesSaved = 0;
+			size_t samplersDeduplicated = 0;
+
+			//Filled when a target error is set: the tolerance picked and the error measured against the source.
+			bool errorMeasured = false;
+			bool withinBudget = false;
+			float tolerance = 0.0f;
+			float maxErrorCm = 0.0f;
+			float meanErrorCm = 0.0f;
+
+			//optimize & export are timed by CreateOptimizedAsset, import & host memory are up to the caller.
+			double importMs = 0.0;
+			double optimizeMs = 0.0;
+			double exportMs = 0.0;
+			//Peak working set of the whole host process over its lifetime, not of this export.
+			size_t hostPeakWorkingSetBytes = 0;
+
+			std::string ToJson() const;
+		};
+
+		//parents is the joint hierarchy the error budget is measured along, see PoseErrorMeasure. Empty uses the skeleton's own.
+		static std::vector<std::byte> CreateOptimizedAsset(Animation::RawOzzAnimation* anim, const ozz::animation::Skeleton* skeleton, uint8_t level = 0, const Animation::JointOverrides* overrides = nullptr, ExportStats* stats = nullptr, std::span<const int16_t> parents = {});
 	};
 }
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "GLTFImport.h"
-#include "zstr.hpp"
 #include "simdjson.h"
 #include "Settings/Settings.h"
+#include "Serialization/Quantization.h"
 
 template <>
 struct fastgltf::ElementTraits<ozz::math::Quaternion> : fastgltf::ElementTraitsBase<ozz::math::Quaternion, AccessorType::Vec4, float>
@@ -13,7 +13,232 @@ struct fastgltf::ElementTraits<ozz::math::Float3> : fastgltf::ElementTraitsBase<
 
 namespace Serialization
 {
-	void ParseMorphChannel(const GLTFImport::AssetData* assetData, const fastgltf::Animation* anim, const fastgltf::AnimationChannel& channel, Animation::RawOzzAnimation* rawAnim)
+	const std::byte* GetBufferBytes(const fastgltf::Buffer& buffer)
+	{
+		if (auto vec = std::get_if<fastgltf::sources::Vector>(&buffer.data)) {
+			return reinterpret_cast<const std::byte*>(vec->bytes.data());
+		} else if (auto view = std::get_if<fastgltf::sources::ByteView>(&buffer.data)) {
+			return view->bytes.data();
+		}
+		return nullptr;
+	}
+
+	//Address of an accessor's first element when it can be read straight out of its buffer, with the stride between elements.
+	const std::byte* LocateAccessorData(const fastgltf::Asset& asset, const fastgltf::Accessor& accessor, size_t elementSize, size_t& stride)
+	{
+		if (accessor.sparse.has_value() || !accessor.bufferViewIndex.has_value())
+			return nullptr;
+
+		auto& view = asset.bufferViews[accessor.bufferViewIndex.value()];
+		const std::byte* bytes = GetBufferBytes(asset.buffers[view.bufferIndex]);
+		stride = view.byteStride.value_or(elementSize);
+
+		if (bytes == nullptr || accessor.byteOffset + (stride * (accessor.count - 1)) + elementSize > view.byteLength)
+			return nullptr;
+
+		return bytes + view.byteOffset + accessor.byteOffset;
+	}
+
+	//Normalized 16-bit data, such as the snorm16 rotations written with rotation quantization on. Components map onto [0, 1]
+	//or [-1, 1] as glTF specifies, and quaternions are renormalized.
+	template <class T>
+	bool ReadNormalized16(const fastgltf::Asset& asset, const fastgltf::Accessor& accessor, std::vector<float>& out)
+	{
+		const size_t components = fastgltf::getNumComponents(accessor.type);
+		size_t stride = 0;
+		const std::byte* src = LocateAccessorData(asset, accessor, components * sizeof(T), stride);
+		if (src == nullptr)
+			return false;
+
+		for (size_t i = 0; i < accessor.count; i++) {
+			const std::byte* element = src + (stride * i);
+			for (size_t c = 0; c < components; c++) {
+				T v;
+				std::memcpy(&v, element + (c * sizeof(T)), sizeof(T));
+				if constexpr (std::is_signed_v<T>) {
+					out[i * components + c] = Quantization::DecodeSnorm16(v);
+				} else {
+					out[i * components + c] = Quantization::DecodeUnorm16(v);
+				}
+			}
+		}
+
+		if (accessor.type == fastgltf::AccessorType::Vec4) {
+			for (size_t i = 0; i < accessor.count; i++) {
+				float* q = &out[i * 4];
+				const float len = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+				if (len > 0.0f) {
+					q[0] /= len;
+					q[1] /= len;
+					q[2] /= len;
+					q[3] /= len;
+				}
+			}
+		}
+		return true;
+	}
+
+	//Decodes a whole accessor into a flat float array (count * components) in one pass. Plain float data is copied straight
+	//out of the buffer (a single memcpy when tightly packed), normalized 16-bit data is expanded directly, and
+	//anything else goes through fastgltf's per-element conversion.
+	void ReadAccessor(const fastgltf::Asset& asset, const fastgltf::Accessor& accessor, std::vector<float>& out)
+	{
+		const size_t components = fastgltf::getNumComponents(accessor.type);
+		const size_t elementSize = components * sizeof(float);
+		out.resize(accessor.count * components);
+		if (accessor.count == 0)
+			return;
+
+		if (accessor.componentType == fastgltf::ComponentType::Float && !accessor.normalized) {
+			size_t stride = 0;
+			if (const std::byte* src = LocateAccessorData(asset, accessor, elementSize, stride); src != nullptr) {
+				if (stride == elementSize) {
+					std::memcpy(out.data(), src, elementSize * accessor.count);
+				} else {
+					for (size_t i = 0; i < accessor.count; i++) {
+						std::memcpy(&out[i * components], src + (stride * i), elementSize);
+					}
+				}
+				return;
+			}
+		} else if (accessor.normalized) {
+			if (accessor.componentType == fastgltf::ComponentType::UnsignedShort && ReadNormalized16<uint16_t>(asset, accessor, out))
+				return;
+			if (accessor.componentType == fastgltf::ComponentType::Short && ReadNormalized16<int16_t>(asset, accessor, out))
+				return;
+		}
+
+		switch (accessor.type) {
+		case fastgltf::AccessorType::Scalar:
+			fastgltf::copyFromAccessor<float>(asset, accessor, out.data());
+			break;
+		case fastgltf::AccessorType::Vec3:
+			fastgltf::copyFromAccessor<ozz::math::Float3>(asset, accessor, out.data());
+			break;
+		case fastgltf::AccessorType::Vec4:
+			fastgltf::copyFromAccessor<ozz::math::Quaternion>(asset, accessor, out.data());
+			break;
+		default:
+			std::fill(out.begin(), out.end(), 0.0f);
+			break;
+		}
+	}
+
+	//Decoded accessor contents, indexed by accessor. Each accessor referenced by the animations being built is decoded
+	//exactly once, no matter how many samplers or animations share it.
+	class AccessorCache
+	{
+	public:
+		explicit AccessorCache(const GLTFImport::AssetData* assetData) :
+			assetData(assetData), decoded(assetData->asset.accessors.size()), requested(assetData->asset.accessors.size(), 0) {}
+
+		void Request(size_t accessorIdx)
+		{
+			if (accessorIdx < requested.size())
+				requested[accessorIdx] = 1;
+		}
+
+		//Adds every accessor referenced by an animation's samplers.
+		void Request(const fastgltf::Animation& anim)
+		{
+			for (auto& c : anim.channels) {
+				if (c.samplerIndex >= anim.samplers.size())
+					continue;
+
+				auto& sampler = anim.samplers[c.samplerIndex];
+				Request(sampler.inputAccessor);
+				Request(sampler.outputAccessor);
+			}
+		}
+
+		void Decode(bool parallel)
+		{
+			std::vector<size_t> pending;
+			for (size_t i = 0; i < requested.size(); i++) {
+				if (requested[i] == 1) {
+					pending.push_back(i);
+					requested[i] = 2;
+				}
+			}
+
+			const auto DecodeOne = [this](size_t idx) {
+				ReadAccessor(assetData->asset, assetData->asset.accessors[idx], decoded[idx]);
+			};
+
+			if (parallel) {
+				std::for_each(std::execution::par, pending.begin(), pending.end(), DecodeOne);
+			} else {
+				std::for_each(pending.begin(), pending.end(), DecodeOne);
+			}
+		}
+
+		const std::vector<float>& Get(size_t accessorIdx) const
+		{
+			return decoded[accessorIdx];
+		}
+
+	private:
+		const GLTFImport::AssetData* assetData;
+		std::vector<std::vector<float>> decoded;
+		std::vector<uint8_t> requested;
+	};
+
+	//GLTF node -> skeleton joint mapping and the bind pose found on the matching nodes. Shared by every animation in an asset.
+	struct NodeMapping
+	{
+		std::vector<size_t> skeletonIdxs;
+		std::vector<ozz::math::Transform> bindPose;
+	};
+
+	NodeMapping BuildNodeMapping(const GLTFImport::AssetData* assetData, const Animation::JointMap* jointMap, size_t numJoints)
+	{
+		auto asset = &assetData->asset;
+		NodeMapping result;
+
+		//Create a map of GLTF node indexes -> skeleton indexes
+		result.skeletonIdxs.reserve(asset->nodes.size());
+
+		ozz::math::Transform identity;
+		identity.rotation = { .0f, .0f, .0f, 1.0f };
+		identity.translation = { .0f, .0f, .0f };
+		result.bindPose.resize(numJoints, identity);
+
+		//Save skeleton bind pose.
+		for (auto nIter = asset->nodes.begin(); nIter != asset->nodes.end(); nIter++) {
+			const auto& n = *nIter;
+			std::string_view nodeName = assetData->GetNodeName(std::distance(asset->nodes.begin(), nIter));
+
+			if (auto jointIdx = jointMap->find(nodeName); jointIdx != Animation::JointMap::npos) {
+				result.skeletonIdxs.push_back(jointIdx);
+				if (std::holds_alternative<fastgltf::TRS>(n.transform)) {
+					auto& trs = std::get<fastgltf::TRS>(n.transform);
+					auto& b = result.bindPose[jointIdx];
+					b.rotation = {
+						trs.rotation[0],
+						trs.rotation[1],
+						trs.rotation[2],
+						trs.rotation[3]
+					};
+					b.translation = {
+						trs.translation[0],
+						trs.translation[1],
+						trs.translation[2]
+					};
+					b.scale = {
+						trs.scale[0],
+						trs.scale[1],
+						trs.scale[2]
+					};
+				}
+			} else {
+				result.skeletonIdxs.push_back(UINT64_MAX);
+			}
+		}
+
+		return result;
+	}
+
+	void ParseMorphChannel(const GLTFImport::AssetData* assetData, const AccessorCache& cache, const fastgltf::Animation* anim, const fastgltf::AnimationChannel& channel, Animation::RawOzzAnimation* rawAnim)
 	{
 		auto asset = &assetData->asset;
 		auto& targetNode = asset->nodes[channel.nodeIndex.value()];
@@ -21,32 +246,31 @@ namespace Serialization
 		if (!targetNode.meshIndex.has_value())
 			return;
 
-		auto iter = assetData->morphTargets.find(targetNode.meshIndex.value());
-		if (iter == assetData->morphTargets.end())
+		auto meshIdx = targetNode.meshIndex.value();
+		if (meshIdx >= assetData->morphIndexMaps.size() || assetData->morphIndexMaps[meshIdx].empty())
 			return;
 
-		auto& morphTargets = iter->second;
+		//GLTF morph index -> game morph index, computed once per mesh at load time.
+		auto gameIdxs = assetData->morphIndexMaps[meshIdx];
+		const size_t targetCount = gameIdxs.size();
 
-		//Create a map of GLTF morph indexes -> game morph indexes
-		std::vector<size_t> morphIdxs;
-		auto gameIdxs = Settings::GetFaceMorphIndexMap();
-		bool hasMorphs = false;
+		//Pairs of (GLTF morph index, game morph index) this channel will write to.
+		std::vector<std::pair<size_t, size_t>> activeTargets;
+		activeTargets.reserve(targetCount);
 
-		for (auto mt : morphTargets) {
-			if (auto iter = gameIdxs.find(mt); iter != gameIdxs.end()) {
-				//If this track has been populated by a different weights channel already, skip over it.
-				if (rawAnim->faceData != nullptr && !rawAnim->faceData->tracks[iter->second].keyframes.empty()) [[unlikely]] {
-					morphIdxs.push_back(UINT64_MAX);
-				} else {
-					morphIdxs.push_back(iter->second);
-					hasMorphs = true;
-				}
-			} else {
-				morphIdxs.push_back(UINT64_MAX);
-			}
+		for (size_t i = 0; i < targetCount; i++) {
+			auto idx = gameIdxs[i];
+			if (idx == UINT64_MAX)
+				continue;
+
+			//If this track has been populated by a different weights channel already, skip over it.
+			if (rawAnim->faceData != nullptr && !rawAnim->faceData->tracks[idx].keyframes.empty()) [[unlikely]]
+				continue;
+
+			activeTargets.emplace_back(i, idx);
 		}
 
-		if (!hasMorphs)
+		if (activeTargets.empty())
 			return;
 
 		//Process GLTF data
@@ -60,7 +284,10 @@ namespace Serialization
 		auto& timeAccessor = asset->accessors[sampler.inputAccessor];
 		auto& dataAccessor = asset->accessors[sampler.outputAccessor];
 
-		if (timeAccessor.count != (dataAccessor.count / morphTargets.size()))
+		if (timeAccessor.count != (dataAccessor.count / targetCount))
+			return;
+
+		if (timeAccessor.type != fastgltf::AccessorType::Scalar || dataAccessor.type != fastgltf::AccessorType::Scalar)
 			return;
 
 		if (!std::holds_alternative<std::pmr::vector<double>>(timeAccessor.max))
@@ -77,36 +304,35 @@ namespace Serialization
 			rawAnim->faceData->duration = duration;
 		}
 
-		ozz::animation::offline::RawTrackKeyframe<float> kf{};
-		kf.interpolation = ozz::animation::offline::RawTrackInterpolation::kLinear;
-		for (size_t i = 0; i < timeAccessor.count; i++) {
-			float time = fastgltf::getAccessorElement<float>(*asset, timeAccessor, i);
-			kf.ratio = (time == 0.0f ? 0.0f : std::clamp(time / duration, 0.0f, 1.0f));
+		auto& times = cache.Get(sampler.inputAccessor);
+		auto& weights = cache.Get(sampler.outputAccessor);
 
-			for (size_t j = 0; j < morphTargets.size(); j++) {
-				auto idx = morphIdxs[j];
-				if (idx == UINT64_MAX)
-					continue;
+		const size_t keyCount = times.size();
+		auto& tracks = rawAnim->faceData->tracks;
+		for (auto& t : activeTargets) {
+			tracks[t.second].keyframes.resize(keyCount);
+		}
 
-				kf.value = fastgltf::getAccessorElement<float>(*asset, dataAccessor, (i * morphTargets.size()) + j);
-				rawAnim->faceData->tracks[idx].keyframes.push_back(kf);
+		//Transpose the interleaved [key][target] weights into per-track keyframes, noting non-zero tracks in the same pass.
+		std::vector<uint8_t> nonZero(activeTargets.size(), 0);
+		for (size_t i = 0; i < keyCount; i++) {
+			float time = times[i];
+			float ratio = (time == 0.0f ? 0.0f : std::clamp(time / duration, 0.0f, 1.0f));
+			const float* keyWeights = &weights[i * targetCount];
+
+			for (size_t j = 0; j < activeTargets.size(); j++) {
+				auto& t = activeTargets[j];
+				auto& kf = tracks[t.second].keyframes[i];
+				kf.interpolation = ozz::animation::offline::RawTrackInterpolation::kLinear;
+				kf.ratio = ratio;
+				kf.value = keyWeights[t.first];
+				nonZero[j] |= (kf.value != 0.0f);
 			}
 		}
 
-		for (size_t i = 0; i < morphTargets.size(); i++) {
-			auto idx = morphIdxs[i];
-			if (idx == UINT64_MAX)
-				continue;
-
-			bool allZero = true;
-			for (auto& k : rawAnim->faceData->tracks[idx].keyframes) {
-				if (k.value != 0.0f) {
-					allZero = false;
-					break;
-				}
-			}
-			if (allZero) {
-				rawAnim->faceData->tracks[idx].keyframes.clear();
+		for (size_t j = 0; j < activeTargets.size(); j++) {
+			if (!nonZero[j]) {
+				tracks[activeTargets[j].second].keyframes.clear();
 			}
 		}
 	}
@@ -119,10 +345,7 @@ namespace Serialization
 
 		for (size_t i = 0; i < assetData->asset.nodes.size(); i++) {
 			const auto& n = assetData->asset.nodes[i];
-			std::string_view curName = n.name;
-			if (auto iter = assetData->originalNames.find(i); iter != assetData->originalNames.end()) {
-				curName = iter->second;
-			}
+			std::string_view curName = assetData->GetNodeName(i);
 
 			if (!nameSet.contains(curName)) {
 				nameSet.insert(curName);
@@ -153,91 +376,87 @@ namespace Serialization
 
 		ozz::animation::offline::SkeletonBuilder builder;
 		result->skeleton = builder(raw);
-		return result;
-	}
+		if (!result->skeleton)
+			return result;
 
-	std::unique_ptr<Animation::RawOzzAnimation> GLTFImport::CreateRawAnimation(const AssetData* assetData, const fastgltf::Animation* anim, const ozz::animation::Skeleton* skeleton)
-	{
-		auto asset = &assetData->asset;
-
-		//Create a map of GLTF node indexes -> skeleton indexes
-		std::vector<size_t> skeletonIdxs;
-		skeletonIdxs.reserve(asset->nodes.size());
-
-		std::map<std::string, size_t> skeletonMap;
-		auto skeletonJointNames = skeleton->joint_names();
-		for (size_t i = 0; i < skeletonJointNames.size(); i++) {
-			skeletonMap[skeletonJointNames[i]] = i;
+		const auto jointNames = result->skeleton->joint_names();
+		std::map<std::string_view, int16_t> nameToJoint;
+		for (size_t j = 0; j < jointNames.size(); j++) {
+			nameToJoint[jointNames[j]] = static_cast<int16_t>(j);
 		}
 
-		ozz::math::Transform identity;
-		identity.rotation = { .0f, .0f, .0f, 1.0f };
-		identity.translation = { .0f, .0f, .0f };
-		std::vector<ozz::math::Transform> bindPose(skeletonMap.size(), identity);
-
-		//Save skeleton bind pose.
-		for (auto nIter = asset->nodes.begin(); nIter != asset->nodes.end(); nIter++) {
-			const auto& n = *nIter;
-			std::string_view nodeName = n.name.c_str();
-
-			if (auto iter = assetData->originalNames.find(std::distance(asset->nodes.begin(), nIter)); iter != assetData->originalNames.end()) {
-				nodeName = iter->second;
+		const auto& nodes = assetData->asset.nodes;
+		std::vector<int64_t> nodeParents(nodes.size(), -1);
+		for (size_t i = 0; i < nodes.size(); i++) {
+			for (auto c : nodes[i].children) {
+				if (c < nodes.size())
+					nodeParents[c] = static_cast<int64_t>(i);
 			}
+		}
 
-			if (auto iter = skeletonMap.find(nodeName.data()); iter != skeletonMap.end()) {
-				skeletonIdxs.push_back(iter->second);
-				if (std::holds_alternative<fastgltf::TRS>(n.transform)) {
-					auto& trs = std::get<fastgltf::TRS>(n.transform);
-					auto& b = bindPose[iter->second];
-					b.rotation = {
-						trs.rotation[0],
-						trs.rotation[1],
-						trs.rotation[2],
-						trs.rotation[3]
-					};
-					b.translation = {
-						trs.translation[0],
-						trs.translation[1],
-						trs.translation[2]
-					};
-					b.scale = {
-						trs.scale[0],
-						trs.scale[1],
-						trs.scale[2]
-					};
+		//A joint takes the hierarchy of the first node with its name, like the rest pose. The walk skips ancestors that
+		//resolve to the joint itself, and is bounded in case the file's hierarchy has a cycle.
+		result->parents.assign(jointNames.size(), -1);
+		std::vector<bool> placed(jointNames.size(), false);
+		for (size_t i = 0; i < nodes.size(); i++) {
+			const int16_t joint = nameToJoint[assetData->GetNodeName(i)];
+			if (placed[joint])
+				continue;
+
+			placed[joint] = true;
+			size_t steps = 0;
+			for (int64_t p = nodeParents[i]; p != -1 && steps < nodes.size(); p = nodeParents[p], steps++) {
+				const int16_t parentJoint = nameToJoint[assetData->GetNodeName(p)];
+				if (parentJoint != joint) {
+					result->parents[joint] = parentJoint;
+					break;
 				}
-			} else {
-				skeletonIdxs.push_back(UINT64_MAX);
 			}
 		}
 
+		result->jointMap.Build(result->skeleton.get());
+		return result;
+	}
+
+	std::unique_ptr<Animation::RawOzzAnimation> BuildRawAnimation(const GLTFImport::AssetData* assetData, const AccessorCache& cache, const NodeMapping& mapping, const fastgltf::Animation* anim, size_t numJoints, bool parallel)
+	{
+		auto asset = &assetData->asset;
+
 		//Create the raw animation
 		auto rawAnimResult = std::make_unique<Animation::RawOzzAnimation>();
 		rawAnimResult->data = ozz::make_unique<ozz::animation::offline::RawAnimation>();
 		auto& animResult = rawAnimResult->data;
 		animResult->duration = 0.001f;
-		animResult->tracks.resize(skeletonMap.size());
+		animResult->tracks.resize(numJoints);
+
+		//Gather channels up front so each joint track has exactly one writer.
+		struct ChannelJob
+		{
+			const std::vector<float>* times;
+			const std::vector<float>* values;
+			fastgltf::AnimationPath path;
+			ozz::animation::offline::RawAnimation::JointTrack* track;
+			float maxTime = 0.0f;
+		};
+
+		std::vector<ChannelJob> jobs;
+		std::vector<const fastgltf::AnimationChannel*> morphChannels;
+		std::vector<uint8_t> claimedPaths(numJoints, 0);
+		jobs.reserve(anim->channels.size());
 
-		//Process GLTF data
-		std::vector<float> times;
 		for (auto& c : anim->channels) {
-			times.clear();
 			if (!c.nodeIndex.has_value() || c.nodeIndex > asset->nodes.size())
 				continue;
 
 			if (c.path == fastgltf::AnimationPath::Weights) {
-				ParseMorphChannel(assetData, anim, c, rawAnimResult.get());
+				morphChannels.push_back(&c);
 				continue;
 			}
 
-			auto idx = skeletonIdxs[c.nodeIndex.value()];
+			auto idx = mapping.skeletonIdxs[c.nodeIndex.value()];
 			if (idx == UINT64_MAX)
 				continue;
 
-			auto& rTl = animResult->tracks[idx].rotations;
-			auto& pTl = animResult->tracks[idx].translations;
-			auto& sTl = animResult->tracks[idx].scales;
-
 			if (c.samplerIndex > anim->samplers.size())
 				continue;
 
@@ -248,42 +467,104 @@ namespace Serialization
 			auto& timeAccessor = asset->accessors[sampler.inputAccessor];
 			auto& dataAccessor = asset->accessors[sampler.outputAccessor];
 
-			if (timeAccessor.count != dataAccessor.count)
+			if (timeAccessor.count != dataAccessor.count || timeAccessor.type != fastgltf::AccessorType::Scalar)
+				continue;
+
+			uint8_t pathBit = 0;
+			fastgltf::AccessorType dataType;
+			switch (c.path) {
+			case fastgltf::AnimationPath::Rotation:
+				pathBit = 1;
+				dataType = fastgltf::AccessorType::Vec4;
+				break;
+			case fastgltf::AnimationPath::Translation:
+				pathBit = 2;
+				dataType = fastgltf::AccessorType::Vec3;
+				break;
+			case fastgltf::AnimationPath::Scale:
+				pathBit = 4;
+				dataType = fastgltf::AccessorType::Vec3;
+				break;
+			default:
+				continue;
+			}
+
+			if (dataAccessor.type != dataType)
+				continue;
+
+			//A second channel targeting the same joint & path would produce an unsorted track, only the first is used.
+			if (claimedPaths[idx] & pathBit)
 				continue;
 
-			ozz::animation::offline::RawAnimation::RotationKey r;
-			ozz::animation::offline::RawAnimation::TranslationKey p;
-			ozz::animation::offline::RawAnimation::ScaleKey s;
-			for (size_t i = 0; i < timeAccessor.count; i++) {
-				float t = fastgltf::getAccessorElement<float>(*asset, timeAccessor, i);
-				if (t > animResult->duration)
-					animResult->duration = t;
-
-				switch (c.path) {
-				case fastgltf::AnimationPath::Rotation:
-					r.value = fastgltf::getAccessorElement<ozz::math::Quaternion>(*asset, dataAccessor, i);
-					r.time = t;
-					rTl.push_back(r);
+			claimedPaths[idx] |= pathBit;
+			jobs.push_back({ &cache.Get(sampler.inputAccessor), &cache.Get(sampler.outputAccessor), c.path, &animResult->tracks[idx] });
+		}
+
+		//Process GLTF data
+		const auto FillChannel = [](ChannelJob& job) {
+			auto& times = *job.times;
+			auto& v = *job.values;
+			for (auto t : times) {
+				if (t > job.maxTime)
+					job.maxTime = t;
+			}
+
+			const size_t keyCount = times.size();
+			switch (job.path) {
+			case fastgltf::AnimationPath::Rotation:
+				{
+					auto& rTl = job.track->rotations;
+					rTl.resize(keyCount);
+					for (size_t i = 0; i < keyCount; i++) {
+						rTl[i].time = times[i];
+						rTl[i].value = { v[i * 4], v[i * 4 + 1], v[i * 4 + 2], v[i * 4 + 3] };
+					}
 					break;
-				case fastgltf::AnimationPath::Translation:
-					p.value = fastgltf::getAccessorElement<ozz::math::Float3>(*asset, dataAccessor, i);
-					p.time = t;
-					pTl.push_back(p);
+				}
+			case fastgltf::AnimationPath::Translation:
+				{
+					auto& pTl = job.track->translations;
+					pTl.resize(keyCount);
+					for (size_t i = 0; i < keyCount; i++) {
+						pTl[i].time = times[i];
+						pTl[i].value = { v[i * 3], v[i * 3 + 1], v[i * 3 + 2] };
+					}
 					break;
-				case fastgltf::AnimationPath::Scale:
-					s.value = fastgltf::getAccessorElement<ozz::math::Float3>(*asset, dataAccessor, i);
-					s.time = t;
-					sTl.push_back(s);
+				}
+			case fastgltf::AnimationPath::Scale:
+				{
+					auto& sTl = job.track->scales;
+					sTl.resize(keyCount);
+					for (size_t i = 0; i < keyCount; i++) {
+						sTl[i].time = times[i];
+						sTl[i].value = { v[i * 3], v[i * 3 + 1], v[i * 3 + 2] };
+					}
 					break;
 				}
 			}
+		};
+
+		if (parallel) {
+			std::for_each(std::execution::par, jobs.begin(), jobs.end(), FillChannel);
+		} else {
+			std::for_each(jobs.begin(), jobs.end(), FillChannel);
+		}
+
+		for (auto& j : jobs) {
+			if (j.maxTime > animResult->duration)
+				animResult->duration = j.maxTime;
 		}
 
-		for (size_t i = 0; i < skeletonMap.size(); i++) {
+		//Morph channels can fill the same face tracks, so they're merged serially in channel order.
+		for (auto c : morphChannels) {
+			ParseMorphChannel(assetData, cache, anim, *c, rawAnimResult.get());
+		}
+
+		for (size_t i = 0; i < numJoints; i++) {
 			auto& rTl = animResult->tracks[i].rotations;
 			auto& pTl = animResult->tracks[i].translations;
 			auto& sTl = animResult->tracks[i].scales;
-			auto& b = bindPose[i];
+			auto& b = mapping.bindPose[i];
 			if (rTl.empty()) {
 				ozz::animation::offline::RawAnimation::RotationKey r;
 				r.time = 0.0001f;
@@ -320,27 +601,182 @@ namespace Serialization
 		return rawAnimResult;
 	}
 
-	std::unique_ptr<GLTFImport::AssetData> GLTFImport::LoadGLTF(const std::filesystem::path& fileName)
+	std::unique_ptr<Animation::RawOzzAnimation> GLTFImport::CreateRawAnimation(const AssetData* assetData, const fastgltf::Animation* anim, const ozz::animation::Skeleton* skeleton, const Animation::JointMap* jointMap, bool parallel)
 	{
-		try {
-			zstr::ifstream file(fileName.generic_string(), std::ios::binary);
+		std::optional<Animation::JointMap> localJointMap;
+		if (jointMap == nullptr) {
+			jointMap = &localJointMap.emplace(skeleton);
+		}
 
-			if (file.bad())
-				return nullptr;
+		const size_t numJoints = skeleton->num_joints();
+		auto mapping = BuildNodeMapping(assetData, jointMap, numJoints);
+
+		AccessorCache cache(assetData);
+		cache.Request(*anim);
+		cache.Decode(parallel);
 
-			std::vector<uint8_t> buffer;
-			std::istreambuf_iterator<char> fileEnd;
+		return BuildRawAnimation(assetData, cache, mapping, anim, numJoints, parallel);
+	}
 
-			for (std::istreambuf_iterator<char> iter(file); iter != fileEnd; iter++) {
-				buffer.push_back(*iter);
+	std::vector<std::unique_ptr<Animation::RawOzzAnimation>> GLTFImport::CreateRawAnimations(const AssetData* assetData, const ozz::animation::Skeleton* skeleton, std::span<const std::string_view> names, const Animation::JointMap* jointMap, bool parallel)
+	{
+		auto& animations = assetData->asset.animations;
+
+		//Resolve which animations to build, in result order.
+		std::vector<const fastgltf::Animation*> targets;
+		if (names.empty()) {
+			for (auto& a : animations) {
+				targets.push_back(&a);
+			}
+		} else {
+			for (auto& n : names) {
+				auto iter = std::find_if(animations.begin(), animations.end(), [&](const fastgltf::Animation& a) { return a.name == n; });
+				targets.push_back(iter != animations.end() ? &(*iter) : nullptr);
 			}
+		}
+
+		std::optional<Animation::JointMap> localJointMap;
+		if (jointMap == nullptr) {
+			jointMap = &localJointMap.emplace(skeleton);
+		}
+
+		const size_t numJoints = skeleton->num_joints();
+		auto mapping = BuildNodeMapping(assetData, jointMap, numJoints);
+
+		//Decode the union of all referenced accessors once, so clips sharing buffers share the work.
+		AccessorCache cache(assetData);
+		for (auto t : targets) {
+			if (t != nullptr)
+				cache.Request(*t);
+		}
+		cache.Decode(parallel);
+
+		std::vector<std::unique_ptr<Animation::RawOzzAnimation>> result(targets.size());
+		const auto BuildOne = [&](size_t i) {
+			if (targets[i] != nullptr)
+				result[i] = BuildRawAnimation(assetData, cache, mapping, targets[i], numJoints, false);
+		};
+
+		std::vector<size_t> idxs(targets.size());
+		std::iota(idxs.begin(), idxs.end(), 0);
+		if (parallel) {
+			std::for_each(std::execution::par, idxs.begin(), idxs.end(), BuildOne);
+		} else {
+			std::for_each(idxs.begin(), idxs.end(), BuildOne);
+		}
+
+		return result;
+	}
+
+	//Produces a writable view of the file contents with fastgltf's required padding past the end, which fastgltf may zero in place.
+	//Uncompressed files are mapped copy-on-write and handed over as-is, so only pages fastgltf writes to get copied.
+	//Compressed files are decompressed into AssetData::sourceBuffer.
+	bool ReadSource(const std::filesystem::path& fileName, GLTFImport::AssetData* assetData, std::span<uint8_t>& result)
+	{
+		const size_t padding = fastgltf::getGltfBufferPadding();
+
+		auto mapping = std::make_unique<Util::File::MappedFile>();
+		if (!mapping->Open(fileName, true))
+			return false;
+
+		auto format = Util::File::DetectFormat(mapping->view().first(std::min<size_t>(mapping->size(), 16)));
+		if (Util::File::IsCompressed(format)) {
+			size_t inflatedSize = Util::File::Decompress(mapping->view(), format, assetData->sourceBuffer, padding, Settings::GetZstdDictionary());
+			if (inflatedSize == 0)
+				return false;
 
-			size_t baseBufferSize = buffer.size();
-			size_t paddedBufferSize = baseBufferSize + fastgltf::getGltfBufferPadding();
-			buffer.resize(paddedBufferSize);
+			result = { assetData->sourceBuffer.data(), inflatedSize };
+			return true;
+		}
+
+		if (mapping->slack() >= padding) {
+			result = mapping->writableView().first(mapping->size());
+			assetData->mappedSource = std::move(mapping);
+			return true;
+		}
+
+		//The file ends too close to a page boundary for the padding to fit, so take a single bulk copy instead.
+		auto& buffer = assetData->sourceBuffer;
+		buffer.resize(mapping->size() + padding);
+		std::memcpy(buffer.data(), mapping->data(), mapping->size());
+		result = { buffer.data(), mapping->size() };
+		return true;
+	}
+
+	struct AnimationLookup
+	{
+		std::vector<bool> keep;
+		bool hasWeights = false;
+	};
+
+	//Scans the glTF JSON for animations by name without building the asset, noting whether any of their channels target morph weights.
+	//The JSON must have fastgltf's padding readable past its end.
+	std::optional<AnimationLookup> FindAnimations(std::span<const uint8_t> source, std::span<const std::string_view> names)
+	{
+		std::span<const uint8_t> json = source;
+		if (Util::File::DetectFormat(source.first(std::min<size_t>(source.size(), 4))) == Util::File::Format::kGLB) {
+			//GLB header is magic, version, length, followed by the JSON chunk's length & type.
+			if (source.size() < 20)
+				return std::nullopt;
+
+			uint32_t jsonLength;
+			std::memcpy(&jsonLength, source.data() + 12, sizeof(jsonLength));
+			if (20ull + jsonLength > source.size())
+				return std::nullopt;
+
+			json = source.subspan(20, jsonLength);
+		}
+
+		simdjson::ondemand::parser parser;
+		simdjson::ondemand::document doc;
+		if (parser.iterate(reinterpret_cast<const char*>(json.data()), json.size(), json.size() + fastgltf::getGltfBufferPadding()).get(doc) != simdjson::error_code::SUCCESS)
+			return std::nullopt;
+
+		simdjson::ondemand::array animations;
+		if (doc["animations"].get_array().get(animations) != simdjson::error_code::SUCCESS)
+			return std::nullopt;
+
+		AnimationLookup result;
+		bool found = false;
+		for (auto a : animations) {
+			std::string_view animName;
+			const bool keep = a["name"].get_string().get(animName) == simdjson::error_code::SUCCESS &&
+			                  std::find(names.begin(), names.end(), animName) != names.end();
+			result.keep.push_back(keep);
+			if (!keep)
+				continue;
+
+			found = true;
+			simdjson::ondemand::array channels;
+			if (result.hasWeights || a["channels"].get_array().get(channels) != simdjson::error_code::SUCCESS)
+				continue;
+
+			for (auto c : channels) {
+				std::string_view path;
+				if (c["target"]["path"].get_string().get(path) == simdjson::error_code::SUCCESS && path == "weights") {
+					result.hasWeights = true;
+					break;
+				}
+			}
+		}
+
+		if (!found)
+			return std::nullopt;
+
+		return result;
+	}
+
+	std::unique_ptr<GLTFImport::AssetData> GLTFImport::LoadGLTF(const std::filesystem::path& fileName, std::span<const std::string_view> animationNames)
+	{
+		try {
+			auto assetData = std::make_unique<AssetData>();
+
+			std::span<uint8_t> source;
+			if (!ReadSource(fileName, assetData.get(), source))
+				return nullptr;
 
 			fastgltf::GltfDataBuffer data;
-			data.fromByteView(buffer.data(), baseBufferSize, paddedBufferSize);
+			data.fromByteView(source.data(), source.size(), source.size() + fastgltf::getGltfBufferPadding());
 
 			fastgltf::Parser parser;
 			auto gltfOptions =
@@ -356,33 +792,61 @@ namespace Serialization
 				fastgltf::Category::Samplers |
 				fastgltf::Category::Accessors;
 
-			auto assetData = std::make_unique<AssetData>();
+			//Selective mode: find the requested animations up front so meshes can be skipped when nothing targets their weights,
+			//and leave the GLB binary chunk in place (AssetData owns the source) rather than copying all of it.
+			std::optional<AnimationLookup> lookup;
+			if (!animationNames.empty()) {
+				lookup = FindAnimations(source, animationNames);
+				if (!lookup.has_value())
+					return nullptr;
+
+				gltfOptions = fastgltf::Options::DecomposeNodeMatrices;
+				gltfCategories =
+					fastgltf::Category::Animations |
+					fastgltf::Category::Nodes |
+					fastgltf::Category::Buffers |
+					fastgltf::Category::BufferViews |
+					fastgltf::Category::Accessors;
+
+				if (lookup->hasWeights) {
+					gltfCategories = gltfCategories | fastgltf::Category::Meshes;
+				}
+			}
+
 			parser.setUserPointer(assetData.get());
 			parser.setExtrasParseCallback([](simdjson::dom::object* extras, std::size_t objectIndex, fastgltf::Category objectType, void* userPointer) {
 				auto assetData = static_cast<AssetData*>(userPointer);
 				if (objectType == fastgltf::Category::Meshes) {
-					auto arr = (*extras)["targetNames"].get_array();
-					if (arr.error() != simdjson::error_code::SUCCESS) {
+					simdjson::dom::array arr;
+					if ((*extras)["targetNames"].get_array().get(arr) != simdjson::error_code::SUCCESS) {
 						return;
 					}
 
+					auto targets = assetData->Allocate<std::string_view>(arr.size());
+					size_t i = 0;
 					std::string_view name;
-					auto& target = assetData->morphTargets[objectIndex];
 					for (auto ele : arr) {
 						if (ele.get_string().get(name) == simdjson::error_code::SUCCESS) {
-							target.emplace_back(name);
+							targets[i++] = assetData->Store(name);
 						} else {
-							assetData->morphTargets.erase(objectIndex);
 							return;
 						}
 					}
+
+					if (assetData->morphTargets.size() <= objectIndex) {
+						assetData->morphTargets.resize(objectIndex + 1);
+					}
+					assetData->morphTargets[objectIndex] = targets;
 				} else if (objectType == fastgltf::Category::Nodes) {
 					auto str = (*extras)["original_name"].get_string();
 					if (str.error() != simdjson::error_code::SUCCESS) {
 						return;
 					}
 
-					assetData->originalNames[objectIndex] = str.value();
+					if (assetData->originalNames.size() <= objectIndex) {
+						assetData->originalNames.resize(objectIndex + 1);
+					}
+					assetData->originalNames[objectIndex] = assetData->Store(str.value());
 				}
 			});
 
@@ -392,6 +856,40 @@ namespace Serialization
 			}
 
 			assetData->asset = std::move(gltf.get());
+
+			if (lookup.has_value()) {
+				auto& anims = assetData->asset.animations;
+				if (lookup->keep.size() != anims.size())
+					return nullptr;
+
+				decltype(assetData->asset.animations) kept;
+				for (size_t i = 0; i < anims.size(); i++) {
+					if (lookup->keep[i])
+						kept.push_back(std::move(anims[i]));
+				}
+				anims = std::move(kept);
+			}
+
+			//Size the extras tables to their object arrays so every lookup is a bounds-checked index.
+			assetData->originalNames.resize(assetData->asset.nodes.size());
+			assetData->morphTargets.resize(assetData->asset.meshes.size());
+			assetData->morphIndexMaps.resize(assetData->asset.meshes.size());
+
+			//Precompute GLTF morph index -> game morph index tables for every mesh with named targets.
+			auto& gameIdxs = Settings::GetFaceMorphIndexMap();
+			for (size_t meshIdx = 0; meshIdx < assetData->morphTargets.size(); meshIdx++) {
+				auto targets = assetData->morphTargets[meshIdx];
+				if (targets.empty())
+					continue;
+
+				auto idxMap = assetData->Allocate<size_t>(targets.size());
+				for (size_t i = 0; i < targets.size(); i++) {
+					auto iter = gameIdxs.find(targets[i]);
+					idxMap[i] = (iter != gameIdxs.end() ? iter->second : UINT64_MAX);
+				}
+				assetData->morphIndexMaps[meshIdx] = idxMap;
+			}
+
 			return assetData;
 		} catch (const std::exception&) {
 			return nullptr;
@@ -1,5 +1,8 @@
 #pragma once
 #include "Animation/Ozz.h"
+#include "Animation/JointMap.h"
+#include "Animation/JointOverrides.h"
+#include "Util/File.h"
 
 namespace Serialization
 {
@@ -8,19 +11,68 @@ namespace Serialization
 	public:
 		struct AssetData
 		{
+			//Backing storage for the file contents. Parsed buffers may point into it, so it lives as long as the asset.
+			std::unique_ptr<Util::File::MappedFile> mappedSource;
+			std::vector<uint8_t> sourceBuffer;
+
+			//Per-import arena for extras data, released in one shot with the asset.
+			std::pmr::monotonic_buffer_resource arena;
+
 			fastgltf::Asset asset;
-			std::map<size_t, std::vector<std::string>> morphTargets;
-			std::map<size_t, std::string> originalNames;
+
+			//Indexed by mesh/node, empty spans/views where the object had no such extras. Storage lives in the arena.
+			std::vector<std::span<std::string_view>> morphTargets;
+			std::vector<std::string_view> originalNames;
+			std::vector<std::span<size_t>> morphIndexMaps;
+
+			template <typename T>
+			std::span<T> Allocate(size_t count)
+			{
+				if (count == 0)
+					return {};
+
+				std::pmr::polymorphic_allocator<T> alloc(&arena);
+				T* data = alloc.allocate(count);
+				std::uninitialized_value_construct_n(data, count);
+				return { data, count };
+			}
+
+			std::string_view Store(std::string_view str)
+			{
+				auto chars = Allocate<char>(str.size());
+				std::copy(str.begin(), str.end(), chars.begin());
+				return { chars.data(), chars.size() };
+			}
+
+			std::string_view GetNodeName(size_t idx) const
+			{
+				if (idx < originalNames.size() && !originalNames[idx].empty())
+					return originalNames[idx];
+
+				return asset.nodes[idx].name;
+			}
 		};
 
 		struct SkeletonData
 		{
 			ozz::unique_ptr<ozz::animation::Skeleton> skeleton;
 			std::vector<ozz::math::Transform> restPose;
+			//The skeleton itself is flat. This is each joint's parent in the glTF node hierarchy, -1 for roots.
+			std::vector<int16_t> parents;
+			Animation::JointMap jointMap;
+			Animation::JointOverrides overrides;
 		};
 		
 		static std::unique_ptr<SkeletonData> BuildSkeleton(const AssetData* assetData);
-		static std::unique_ptr<Animation::RawOzzAnimation> CreateRawAnimation(const AssetData* assetData, const fastgltf::Animation* anim, const ozz::animation::Skeleton* skeleton);
-		static std::unique_ptr<AssetData> LoadGLTF(const std::filesystem::path& fileName);
+		static std::unique_ptr<Animation::RawOzzAnimation> CreateRawAnimation(const AssetData* assetData, const fastgltf::Animation* anim, const ozz::animation::Skeleton* skeleton, const Animation::JointMap* jointMap = nullptr, bool parallel = false);
+		//Builds every animation in the asset, or only the ones listed in names, decoding shared accessors once.
+		//With names given, the result follows their order and holds nullptr for any name that wasn't found.
+		static std::vector<std::unique_ptr<Animation::RawOzzAnimation>> CreateRawAnimations(const AssetData* assetData, const ozz::animation::Skeleton* skeleton, std::span<const std::string_view> names = {}, const Animation::JointMap* jointMap = nullptr, bool parallel = false);
+
+		//With animationNames given, only the animations with those names are kept, in file order. Meshes are only parsed if one
+		//of them has a weights channel, and GLB buffer data is referenced in place instead of copied. Accessors, buffer views &
+		//nodes are still parsed in full, but CreateRawAnimations only decodes the accessors the kept animations reference.
+		//Returns nullptr if none of the names exist.
+		static std::unique_ptr<AssetData> LoadGLTF(const std::filesystem::path& fileName, std::span<const std::string_view> animationNames = {});
 	};
 }
\ No newline at end of file
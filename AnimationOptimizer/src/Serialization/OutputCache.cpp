@@ -0,0 +1,123 @@
+#include "OutputCache.h"
+#include "OzzCache.h"
+#include "Animation/JointOverrides.h"
+#include "Settings/Settings.h"
+#include "Util/Hash.h"
+
+namespace Serialization
+{
+	namespace
+	{
+		uint64_t Combine(uint64_t hash, float value)
+		{
+			return Util::Hash::Hash64(&value, sizeof(value), hash);
+		}
+
+		bool CopyAtomic(const std::filesystem::path& from, const std::filesystem::path& to)
+		{
+			std::error_code ec;
+			auto tempPath = to;
+			tempPath += std::format(".{}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+			if (!std::filesystem::copy_file(from, tempPath, std::filesystem::copy_options::overwrite_existing, ec))
+				return false;
+
+			std::filesystem::rename(tempPath, to, ec);
+			if (ec) {
+				std::filesystem::remove(tempPath, ec);
+				return false;
+			}
+			return true;
+		}
+	}
+
+	uint64_t OutputCache::HashConfig(const std::filesystem::path& skeletonPath, uint8_t level, bool additive)
+	{
+		if (Settings::GetOutputCacheDirectory().empty())
+			return 0;
+
+		const uint64_t skeletonHash = OzzCache::HashFile(skeletonPath);
+		if (skeletonHash == 0)
+			return 0;
+
+		uint64_t hash = Util::Hash::Combine(Version, skeletonHash);
+		//A missing sidecar hashes to 0, same as no overrides.
+		hash = Util::Hash::Combine(hash, OzzCache::HashFile(Animation::JointOverrides::GetSidecarPath(skeletonPath)));
+		hash = Util::Hash::Combine(hash, level);
+		hash = Util::Hash::Combine(hash, additive);
+
+		auto& morphs = Settings::GetFaceMorphs();
+		hash = Util::Hash::Combine(hash, morphs.size());
+		for (auto& m : morphs) {
+			hash = Util::Hash::Hash64(m.data(), m.size() + 1, hash);
+		}
+
+		hash = Combine(hash, Settings::GetResampleRate());
+		hash = Util::Hash::Combine(hash, Settings::GetElideConstantTracks());
+		hash = Combine(hash, Settings::GetTargetError());
+		hash = Util::Hash::Combine(hash, Settings::GetErrorSampleCount());
+		hash = Combine(hash, Settings::GetMorphTolerance());
+		hash = Util::Hash::Combine(hash, static_cast<uint64_t>(Settings::GetZstdLevel()));
+		hash = Util::Hash::Combine(hash, Settings::GetQuantizeRotations());
+
+		auto dictionary = Settings::GetZstdDictionary();
+		return Util::Hash::Hash64(dictionary.data(), dictionary.size(), hash);
+	}
+
+	uint64_t OutputCache::GetKey(uint64_t configHash, const std::filesystem::path& inputPath)
+	{
+		if (configHash == 0)
+			return 0;
+
+		const uint64_t inputHash = OzzCache::HashFile(inputPath);
+		if (inputHash == 0)
+			return 0;
+
+		return Util::Hash::Combine(configHash, inputHash);
+	}
+
+	std::filesystem::path OutputCache::GetEntryPath(uint64_t key, std::string_view extension)
+	{
+		return Settings::GetOutputCacheDirectory() / std::format("{:016x}{}", key, extension);
+	}
+
+	bool OutputCache::Restore(uint64_t key, const std::filesystem::path& outputPath)
+	{
+		if (key == 0)
+			return false;
+
+		std::error_code ec;
+		auto entryPath = GetEntryPath(key);
+		if (!std::filesystem::exists(entryPath, ec))
+			return false;
+
+		//The .ozz is keyed to the output's bytes, which are identical on a hit, so a copy of it stays valid.
+		const bool runtimeCache = Settings::GetWriteRuntimeCache();
+		auto ozzEntryPath = GetEntryPath(key, ".ozz");
+		if (runtimeCache && !std::filesystem::exists(ozzEntryPath, ec))
+			return false;
+
+		if (!std::filesystem::copy_file(entryPath, outputPath, std::filesystem::copy_options::overwrite_existing, ec))
+			return false;
+
+		return !runtimeCache || std::filesystem::copy_file(ozzEntryPath, OzzCache::GetCachePath(outputPath), std::filesystem::copy_options::overwrite_existing, ec);
+	}
+
+	bool OutputCache::Store(uint64_t key, const std::filesystem::path& outputPath)
+	{
+		if (key == 0)
+			return false;
+
+		std::error_code ec;
+		auto entryPath = GetEntryPath(key);
+		std::filesystem::create_directories(entryPath.parent_path(), ec);
+
+		//The .ozz goes first, so a reader that finds the .bin also finds it.
+		if (Settings::GetWriteRuntimeCache()) {
+			auto ozzPath = OzzCache::GetCachePath(outputPath);
+			if (!std::filesystem::exists(ozzPath, ec) || !CopyAtomic(ozzPath, GetEntryPath(key, ".ozz")))
+				return false;
+		}
+
+		return CopyAtomic(outputPath, entryPath);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+namespace Serialization
+{
+	//Content-addressed store of optimized output files, so re-running the optimizer over an unchanged library only copies files.
+	//Entries are named after a hash of the input bytes and everything else that affects the output: the skeleton file & its
+	//overrides sidecar, the level, the additive flag, the morph list and the export settings. Nothing is ever invalidated,
+	//changing any of those simply produces new keys. The directory can be deleted at any time.
+	//With the runtime cache enabled, an entry also holds the output's .ozz, and an entry without one is treated as a miss.
+	class OutputCache
+	{
+	public:
+		static constexpr uint32_t Version = 1;
+
+		//Hash of everything but the input file. 0 if the cache is disabled or the skeleton can't be read.
+		static uint64_t HashConfig(const std::filesystem::path& skeletonPath, uint8_t level, bool additive);
+		//Combines a HashConfig result with the input file's bytes. 0 if the input can't be read.
+		static uint64_t GetKey(uint64_t configHash, const std::filesystem::path& inputPath);
+
+		static std::filesystem::path GetEntryPath(uint64_t key, std::string_view extension = ".bin");
+
+		//Copies the cached output for key to outputPath, plus its runtime cache if that is enabled. Returns false on a miss.
+		static bool Restore(uint64_t key, const std::filesystem::path& outputPath);
+		//Stores a copy of outputPath, and of its runtime cache if that is enabled, under key. Entries are written to a temporary file first, so a concurrent reader
+		//never sees a partial entry.
+		static bool Store(uint64_t key, const std::filesystem::path& outputPath);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,202 @@
+#include "OzzCache.h"
+#include "Util/File.h"
+#include "Util/Hash.h"
+#include "ozz/base/io/archive.h"
+#include "ozz/base/io/stream.h"
+
+namespace Serialization
+{
+	namespace
+	{
+		//Read-only ozz stream over memory owned by someone else, used to deserialize straight out of a mapped file.
+		class SpanStream : public ozz::io::Stream
+		{
+		public:
+			explicit SpanStream(std::span<const uint8_t> data) :
+				data(data) {}
+
+			bool opened() const override
+			{
+				return true;
+			}
+
+			size_t Read(void* buffer, size_t size) override
+			{
+				const size_t count = std::min(size, data.size() - position);
+				std::memcpy(buffer, data.data() + position, count);
+				position += count;
+				return count;
+			}
+
+			size_t Write(const void*, size_t) override
+			{
+				return 0;
+			}
+
+			int Seek(int offset, Origin origin) override
+			{
+				int64_t base = 0;
+				switch (origin) {
+				case kCurrent:
+					base = static_cast<int64_t>(position);
+					break;
+				case kEnd:
+					base = static_cast<int64_t>(data.size());
+					break;
+				case kSet:
+					break;
+				}
+
+				const int64_t target = base + offset;
+				if (target < 0 || target > static_cast<int64_t>(data.size()))
+					return -1;
+
+				position = static_cast<size_t>(target);
+				return 0;
+			}
+
+			int Tell() const override
+			{
+				return static_cast<int>(position);
+			}
+
+			size_t Size() const override
+			{
+				return data.size();
+			}
+
+		private:
+			std::span<const uint8_t> data;
+			size_t position = 0;
+		};
+	}
+
+	std::filesystem::path OzzCache::GetCachePath(const std::filesystem::path& sourcePath)
+	{
+		auto result = sourcePath;
+		result += ".ozz";
+		return result;
+	}
+
+	uint64_t OzzCache::HashFile(const std::filesystem::path& path)
+	{
+		Util::File::MappedFile file;
+		if (!file.Open(path))
+			return 0;
+
+		return Util::Hash::Hash64(file.data(), file.size());
+	}
+
+	uint64_t OzzCache::HashSkeleton(const ozz::animation::Skeleton* skeleton)
+	{
+		uint64_t hash = Util::Hash::Combine(0, skeleton->num_joints());
+		for (auto name : skeleton->joint_names()) {
+			hash = Util::Hash::Hash64(name, std::strlen(name), hash);
+		}
+
+		auto parents = skeleton->joint_parents();
+		hash = Util::Hash::Hash64(parents.data(), parents.size_bytes(), hash);
+
+		auto restPoses = skeleton->joint_rest_poses();
+		return Util::Hash::Hash64(restPoses.data(), restPoses.size_bytes(), hash);
+	}
+
+	bool OzzCache::Write(const std::filesystem::path& sourcePath, const Animation::RawOzzAnimation* anim, const ozz::animation::Skeleton* skeleton)
+	{
+		if (anim == nullptr || anim->data == nullptr || skeleton == nullptr)
+			return false;
+
+		Header header;
+		header.sourceHash = HashFile(sourcePath);
+		header.skeletonHash = HashSkeleton(skeleton);
+		if (header.sourceHash == 0)
+			return false;
+
+		ozz::animation::offline::AnimationBuilder animBuilder;
+		auto animation = animBuilder(*anim->data);
+		if (!animation)
+			return false;
+
+		ozz::io::MemoryStream stream;
+		ozz::io::OArchive archive(&stream);
+		archive << *animation;
+
+		const uint32_t faceCount = anim->faceData != nullptr ? static_cast<uint32_t>(anim->faceData->tracks.size()) : 0;
+		archive << faceCount;
+		if (faceCount > 0) {
+			ozz::animation::offline::TrackBuilder trackBuilder;
+			for (auto& t : anim->faceData->tracks) {
+				auto track = trackBuilder(t);
+				if (!track)
+					return false;
+
+				archive << *track;
+			}
+		}
+
+		std::vector<char> payload(stream.Size());
+		stream.Seek(0, ozz::io::Stream::kSet);
+		if (stream.Read(payload.data(), payload.size()) != payload.size())
+			return false;
+
+		try {
+			std::ofstream file(GetCachePath(sourcePath), std::ios::binary | std::ios::trunc);
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(payload.data(), payload.size());
+			return file.good();
+		} catch (const std::exception&) {
+			return false;
+		}
+	}
+
+	std::unique_ptr<OzzCache::CachedAnimation> OzzCache::Load(const std::filesystem::path& sourcePath, const ozz::animation::Skeleton* skeleton)
+	{
+		const uint64_t sourceHash = HashFile(sourcePath);
+		if (sourceHash == 0 || skeleton == nullptr)
+			return nullptr;
+
+		return Load(GetCachePath(sourcePath), sourceHash, HashSkeleton(skeleton));
+	}
+
+	std::unique_ptr<OzzCache::CachedAnimation> OzzCache::Load(const std::filesystem::path& cachePath, uint64_t sourceHash, uint64_t skeletonHash)
+	{
+		Util::File::MappedFile file;
+		if (!file.Open(cachePath) || file.size() < sizeof(Header))
+			return nullptr;
+
+		Header header;
+		std::memcpy(&header, file.data(), sizeof(header));
+		if (header.magic != Magic ||
+			header.version != Version ||
+			header.sourceHash != sourceHash ||
+			header.skeletonHash != skeletonHash) {
+			return nullptr;
+		}
+
+		SpanStream stream(file.view().subspan(sizeof(Header)));
+		ozz::io::IArchive archive(&stream);
+
+		auto result = std::make_unique<CachedAnimation>();
+		if (!archive.TestTag<ozz::animation::Animation>())
+			return nullptr;
+
+		result->animation = ozz::make_unique<ozz::animation::Animation>();
+		archive >> *result->animation;
+
+		uint32_t faceCount = 0;
+		archive >> faceCount;
+		if (faceCount > std::tuple_size_v<decltype(Animation::RawOzzFaceAnimation::tracks)>)
+			return nullptr;
+
+		result->faceTracks.reserve(faceCount);
+		for (uint32_t i = 0; i < faceCount; i++) {
+			if (!archive.TestTag<ozz::animation::FloatTrack>())
+				return nullptr;
+
+			auto& track = result->faceTracks.emplace_back(ozz::make_unique<ozz::animation::FloatTrack>());
+			archive >> *track;
+		}
+
+		return result;
+	}
+}
\ No newline at end of file
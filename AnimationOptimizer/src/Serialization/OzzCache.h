@@ -0,0 +1,45 @@
+#pragma once
+#include "Animation/Ozz.h"
+
+namespace Serialization
+{
+	//Prebuilt ozz runtime animations stored next to their GLB source as <source>.ozz, so hot clips can skip the glTF parse,
+	//RawAnimation conversion and AnimationBuilder pass. The file is a small header followed by an ozz archive holding the
+	//animation and its face tracks. It is only valid for the exact source bytes & skeleton it was built from, which Load checks.
+	//Load is the reference reader for the format, and the optimizer reads every file back through it after writing.
+	class OzzCache
+	{
+	public:
+		static constexpr uint32_t Magic = 0x4F46414E;  //"NAFO"
+		static constexpr uint32_t Version = 1;
+
+		struct Header
+		{
+			uint32_t magic = Magic;
+			uint32_t version = Version;
+			uint64_t sourceHash = 0;
+			uint64_t skeletonHash = 0;
+		};
+
+		struct CachedAnimation
+		{
+			ozz::unique_ptr<ozz::animation::Animation> animation;
+			std::vector<ozz::unique_ptr<ozz::animation::FloatTrack>> faceTracks;
+		};
+
+		static std::filesystem::path GetCachePath(const std::filesystem::path& sourcePath);
+
+		//Hash of the file's bytes as stored on disk, 0 if it can't be read.
+		static uint64_t HashFile(const std::filesystem::path& path);
+		//Hash of joint names, hierarchy & rest pose.
+		static uint64_t HashSkeleton(const ozz::animation::Skeleton* skeleton);
+
+		//Builds anim into its runtime form and writes it to the cache path of sourcePath, keyed by the source's current contents.
+		//anim must be what the GLB decodes to, so the cache plays back exactly like the file it is keyed to.
+		static bool Write(const std::filesystem::path& sourcePath, const Animation::RawOzzAnimation* anim, const ozz::animation::Skeleton* skeleton);
+
+		//Returns nullptr if there's no cache, or it was built from other source bytes, another skeleton or an older version.
+		static std::unique_ptr<CachedAnimation> Load(const std::filesystem::path& sourcePath, const ozz::animation::Skeleton* skeleton);
+		static std::unique_ptr<CachedAnimation> Load(const std::filesystem::path& cachePath, uint64_t sourceHash, uint64_t skeletonHash);
+	};
+}
\ No newline at end of file
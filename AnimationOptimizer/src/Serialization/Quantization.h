@@ -0,0 +1,23 @@
+#pragma once
+
+namespace Serialization::Quantization
+{
+	constexpr float Unorm16Max = 65535.0f;
+	constexpr float Snorm16Max = 32767.0f;
+
+	inline float DecodeUnorm16(uint16_t value)
+	{
+		return static_cast<float>(value) / Unorm16Max;
+	}
+
+	//glTF normalized signed short: -32768 and -32767 both decode to -1.
+	inline int16_t EncodeSnorm16(float value)
+	{
+		return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * Snorm16Max));
+	}
+
+	inline float DecodeSnorm16(int16_t value)
+	{
+		return std::max(static_cast<float>(value) / Snorm16Max, -1.0f);
+	}
+}
\ No newline at end of file
@@ -2,8 +2,18 @@
 
 namespace Settings
 {
-	std::map<std::string, size_t> idxMap;
+	std::map<std::string, size_t, std::less<>> idxMap;
 	std::vector<std::string> morphs;
+	float resampleRate = 0.0f;
+	bool elideConstantTracks = false;
+	bool writeRuntimeCache = false;
+	float targetError = 0.0f;
+	uint32_t errorSampleCount = 60;
+	float morphTolerance = 1e-3f;
+	int zstdLevel = 0;
+	std::vector<uint8_t> zstdDictionary;
+	std::filesystem::path outputCacheDirectory;
+	bool quantizeRotations = false;
 
 	void SetFaceMorphs(const std::vector<std::string>& a_morphs)
 	{
@@ -14,7 +24,7 @@ namespace Settings
 		}
 	}
 
-	const std::map<std::string, size_t>& GetFaceMorphIndexMap()
+	const std::map<std::string, size_t, std::less<>>& GetFaceMorphIndexMap()
 	{
 		return idxMap;
 	}
@@ -23,4 +33,102 @@ namespace Settings
 	{
 		return morphs;
 	}
+
+	void SetResampleRate(float a_rate)
+	{
+		resampleRate = std::max(a_rate, 0.0f);
+	}
+
+	float GetResampleRate()
+	{
+		return resampleRate;
+	}
+
+	void SetElideConstantTracks(bool a_elide)
+	{
+		elideConstantTracks = a_elide;
+	}
+
+	bool GetElideConstantTracks()
+	{
+		return elideConstantTracks;
+	}
+
+	void SetWriteRuntimeCache(bool a_write)
+	{
+		writeRuntimeCache = a_write;
+	}
+
+	bool GetWriteRuntimeCache()
+	{
+		return writeRuntimeCache;
+	}
+
+	void SetTargetError(float a_errorCm, uint32_t a_sampleCount)
+	{
+		targetError = std::max(a_errorCm, 0.0f);
+		if (a_sampleCount >= 2) {
+			errorSampleCount = a_sampleCount;
+		}
+	}
+
+	float GetTargetError()
+	{
+		return targetError;
+	}
+
+	uint32_t GetErrorSampleCount()
+	{
+		return errorSampleCount;
+	}
+
+	void SetMorphTolerance(float a_tolerance)
+	{
+		morphTolerance = std::max(a_tolerance, 0.0f);
+	}
+
+	float GetMorphTolerance()
+	{
+		return morphTolerance;
+	}
+
+	void SetZstdLevel(int a_level)
+	{
+		zstdLevel = std::max(a_level, 0);
+	}
+
+	int GetZstdLevel()
+	{
+		return zstdLevel;
+	}
+
+	void SetZstdDictionary(std::vector<uint8_t>&& a_dictionary)
+	{
+		zstdDictionary = std::move(a_dictionary);
+	}
+
+	std::span<const uint8_t> GetZstdDictionary()
+	{
+		return zstdDictionary;
+	}
+
+	void SetOutputCacheDirectory(const std::filesystem::path& a_directory)
+	{
+		outputCacheDirectory = a_directory;
+	}
+
+	const std::filesystem::path& GetOutputCacheDirectory()
+	{
+		return outputCacheDirectory;
+	}
+
+	void SetQuantizeRotations(bool a_quantize)
+	{
+		quantizeRotations = a_quantize;
+	}
+
+	bool GetQuantizeRotations()
+	{
+		return quantizeRotations;
+	}
 }
\ No newline at end of file
@@ -4,6 +4,25 @@
 namespace Settings
 {
 	void SetFaceMorphs(const std::vector<std::string>& a_morphs);
-	const std::map<std::string, size_t>& GetFaceMorphIndexMap();
+	const std::map<std::string, size_t, std::less<>>& GetFaceMorphIndexMap();
 	const std::vector<std::string>& GetFaceMorphs();
+	void SetResampleRate(float a_rate);
+	float GetResampleRate();
+	void SetElideConstantTracks(bool a_elide);
+	bool GetElideConstantTracks();
+	void SetWriteRuntimeCache(bool a_write);
+	bool GetWriteRuntimeCache();
+	void SetTargetError(float a_errorCm, uint32_t a_sampleCount);
+	float GetTargetError();
+	uint32_t GetErrorSampleCount();
+	void SetMorphTolerance(float a_tolerance);
+	float GetMorphTolerance();
+	void SetZstdLevel(int a_level);
+	int GetZstdLevel();
+	void SetZstdDictionary(std::vector<uint8_t>&& a_dictionary);
+	std::span<const uint8_t> GetZstdDictionary();
+	void SetOutputCacheDirectory(const std::filesystem::path& a_directory);
+	const std::filesystem::path& GetOutputCacheDirectory();
+	void SetQuantizeRotations(bool a_quantize);
+	bool GetQuantizeRotations();
 }
\ No newline at end of file
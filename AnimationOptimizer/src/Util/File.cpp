@@ -0,0 +1,328 @@
+#include "File.h"
+#include "zlib.h"
+#include "zstd.h"
+#include "zdict.h"
+
+namespace Util::File
+{
+	Format DetectFormat(const std::span<const uint8_t> a_header)
+	{
+		if (a_header.size() >= 4 && std::memcmp(a_header.data(), "glTF", 4) == 0)
+			return Format::kGLB;
+
+		if (a_header.size() >= 4 && a_header[0] == 0x28 && a_header[1] == 0xB5 && a_header[2] == 0x2F && a_header[3] == 0xFD)
+			return Format::kZstd;
+
+		if (a_header.size() >= 2) {
+			if (a_header[0] == 0x1F && a_header[1] == 0x8B)
+				return Format::kGzip;
+
+			//Same check zstr uses: CMF/FLG pair must be a multiple of 31.
+			if (a_header[0] == 0x78 && ((a_header[0] << 8) | a_header[1]) % 31 == 0)
+				return Format::kZlib;
+		}
+
+		for (auto c : a_header) {
+			if (c == '{')
+				return Format::kJSON;
+
+			//Skip leading whitespace and a UTF-8 BOM.
+			if (c != ' ' && c != '\t' && c != '\r' && c != '\n' && c != 0xEF && c != 0xBB && c != 0xBF)
+				break;
+		}
+
+		return Format::kUnknown;
+	}
+
+	bool IsCompressed(Format a_format)
+	{
+		return a_format == Format::kGzip || a_format == Format::kZlib || a_format == Format::kZstd;
+	}
+
+	size_t Inflate(const std::span<const uint8_t> a_input, Format a_format, std::vector<uint8_t>& a_output, size_t a_padding)
+	{
+		constexpr size_t blockSize = 1 << 20;
+
+		if ((a_format != Format::kGzip && a_format != Format::kZlib) || a_input.size() < 2)
+			return 0;
+
+		//gzip stores the uncompressed size mod 2^32 in its last 4 bytes. It only describes the final member
+		//and can't account for files over 4GB, so it is treated as a hint and the buffer still grows if needed.
+		size_t expectedSize = 0;
+		if (a_format == Format::kGzip && a_input.size() >= 18) {
+			const uint8_t* trailer = a_input.data() + a_input.size() - 4;
+			expectedSize = static_cast<size_t>(trailer[0]) |
+			               (static_cast<size_t>(trailer[1]) << 8) |
+			               (static_cast<size_t>(trailer[2]) << 16) |
+			               (static_cast<size_t>(trailer[3]) << 24);
+		}
+
+		//Deflate can't exceed ~1032:1, anything beyond that is a corrupt trailer.
+		if (expectedSize == 0 || expectedSize > a_input.size() * 1032) {
+			expectedSize = a_input.size() * 4;
+		}
+
+		z_stream strm{};
+		//15 window bits + 32 enables automatic gzip/zlib header detection.
+		if (inflateInit2(&strm, 15 + 32) != Z_OK)
+			return 0;
+
+		a_output.resize(expectedSize + a_padding);
+
+		const uint8_t* inPos = a_input.data();
+		size_t inRemaining = a_input.size();
+		size_t outSize = 0;
+		int ret = Z_OK;
+
+		while (true) {
+			if (strm.avail_in == 0 && inRemaining > 0) {
+				strm.next_in = const_cast<Bytef*>(inPos);
+				strm.avail_in = static_cast<uInt>(std::min<size_t>(inRemaining, UINT_MAX));
+				inPos += strm.avail_in;
+				inRemaining -= strm.avail_in;
+			}
+
+			if (outSize == a_output.size() - a_padding) {
+				a_output.resize((outSize * 2) + a_padding);
+			}
+
+			const size_t outAvailable = std::min(blockSize, a_output.size() - a_padding - outSize);
+			strm.next_out = a_output.data() + outSize;
+			strm.avail_out = static_cast<uInt>(outAvailable);
+
+			ret = inflate(&strm, Z_NO_FLUSH);
+			outSize += outAvailable - strm.avail_out;
+
+			if (ret == Z_STREAM_END) {
+				//Concatenated gzip members are valid, keep going if another one follows.
+				if (strm.avail_in == 0 && inRemaining == 0)
+					break;
+
+				if (inflateReset(&strm) != Z_OK)
+					break;
+			} else if (ret != Z_OK && !(ret == Z_BUF_ERROR && strm.avail_out == 0)) {
+				break;
+			}
+		}
+
+		inflateEnd(&strm);
+
+		if (ret != Z_STREAM_END) {
+			a_output.clear();
+			return 0;
+		}
+
+		a_output.resize(outSize + a_padding);
+		std::memset(a_output.data() + outSize, 0, a_padding);
+		return outSize;
+	}
+
+	size_t DecompressZstd(const std::span<const uint8_t> a_input, std::vector<uint8_t>& a_output, size_t a_padding, const std::span<const uint8_t> a_dictionary)
+	{
+		//Frames written by CompressZstd always carry their content size, others fall back to a guess and grow.
+		size_t expectedSize = a_input.size() * 4;
+		const unsigned long long contentSize = ZSTD_getFrameContentSize(a_input.data(), a_input.size());
+		if (contentSize == ZSTD_CONTENTSIZE_ERROR)
+			return 0;
+		if (contentSize != ZSTD_CONTENTSIZE_UNKNOWN && contentSize > 0) {
+			expectedSize = static_cast<size_t>(contentSize);
+		}
+
+		ZSTD_DCtx* dctx = ZSTD_createDCtx();
+		if (dctx == nullptr)
+			return 0;
+
+		if (ZSTD_getDictID_fromFrame(a_input.data(), a_input.size()) != 0) {
+			if (a_dictionary.empty() || ZSTD_isError(ZSTD_DCtx_loadDictionary(dctx, a_dictionary.data(), a_dictionary.size()))) {
+				ZSTD_freeDCtx(dctx);
+				return 0;
+			}
+		}
+
+		a_output.resize(expectedSize + a_padding);
+
+		ZSTD_inBuffer in{ a_input.data(), a_input.size(), 0 };
+		size_t outSize = 0;
+		size_t ret = 0;
+		while (true) {
+			if (outSize == a_output.size() - a_padding) {
+				a_output.resize((outSize * 2) + a_padding);
+			}
+
+			ZSTD_outBuffer out{ a_output.data() + outSize, a_output.size() - a_padding - outSize, 0 };
+			ret = ZSTD_decompressStream(dctx, &out, &in);
+			outSize += out.pos;
+
+			if (ZSTD_isError(ret))
+				break;
+
+			//0 means a frame was fully decoded & flushed. Concatenated frames are valid, so keep going while input remains.
+			if (ret == 0 && in.pos == in.size)
+				break;
+
+			if (in.pos == in.size && out.pos < out.size) {
+				//Truncated input, zstd wants more than there is.
+				ret = static_cast<size_t>(-ZSTD_error_srcSize_wrong);
+				break;
+			}
+		}
+
+		ZSTD_freeDCtx(dctx);
+
+		if (ZSTD_isError(ret)) {
+			a_output.clear();
+			return 0;
+		}
+
+		a_output.resize(outSize + a_padding);
+		std::memset(a_output.data() + outSize, 0, a_padding);
+		return outSize;
+	}
+
+	size_t Decompress(const std::span<const uint8_t> a_input, Format a_format, std::vector<uint8_t>& a_output, size_t a_padding, const std::span<const uint8_t> a_dictionary)
+	{
+		if (a_format == Format::kZstd)
+			return DecompressZstd(a_input, a_output, a_padding, a_dictionary);
+
+		return Inflate(a_input, a_format, a_output, a_padding);
+	}
+
+	bool CompressZstd(const std::span<const uint8_t> a_input, int a_level, std::vector<uint8_t>& a_output, const std::span<const uint8_t> a_dictionary)
+	{
+		ZSTD_CCtx* cctx = ZSTD_createCCtx();
+		if (cctx == nullptr)
+			return false;
+
+		bool ok = !ZSTD_isError(ZSTD_CCtx_setParameter(cctx, ZSTD_c_compressionLevel, a_level)) &&
+		          !ZSTD_isError(ZSTD_CCtx_setParameter(cctx, ZSTD_c_checksumFlag, 1));
+		if (ok && !a_dictionary.empty()) {
+			ok = !ZSTD_isError(ZSTD_CCtx_loadDictionary(cctx, a_dictionary.data(), a_dictionary.size()));
+		}
+
+		if (ok) {
+			a_output.resize(ZSTD_compressBound(a_input.size()));
+			const size_t written = ZSTD_compress2(cctx, a_output.data(), a_output.size(), a_input.data(), a_input.size());
+			ok = !ZSTD_isError(written);
+			a_output.resize(ok ? written : 0);
+		}
+
+		ZSTD_freeCCtx(cctx);
+		return ok;
+	}
+
+	std::vector<uint8_t> TrainZstdDictionary(const std::vector<std::vector<uint8_t>>& a_samples, size_t a_capacity)
+	{
+		std::vector<uint8_t> samples;
+		std::vector<size_t> sampleSizes;
+		sampleSizes.reserve(a_samples.size());
+		for (auto& s : a_samples) {
+			if (s.empty())
+				continue;
+
+			samples.insert(samples.end(), s.begin(), s.end());
+			sampleSizes.push_back(s.size());
+		}
+
+		std::vector<uint8_t> result(a_capacity);
+		if (sampleSizes.empty() || result.empty())
+			return {};
+
+		const size_t size = ZDICT_trainFromBuffer(result.data(), result.size(), samples.data(), sampleSizes.data(), static_cast<unsigned>(sampleSizes.size()));
+		if (ZDICT_isError(size))
+			return {};
+
+		result.resize(size);
+		return result;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const std::filesystem::path& a_path, bool a_copyOnWrite)
+	{
+		Close();
+
+		fileHandle = CreateFileW(a_path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (fileHandle == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart <= 0) {
+			Close();
+			return false;
+		}
+
+		mappingHandle = CreateFileMappingW(fileHandle, NULL, a_copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+		if (mappingHandle == NULL) {
+			Close();
+			return false;
+		}
+
+		mappedData = static_cast<uint8_t*>(MapViewOfFile(mappingHandle, a_copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0));
+		if (mappedData == nullptr) {
+			Close();
+			return false;
+		}
+
+		SYSTEM_INFO sysInfo;
+		GetSystemInfo(&sysInfo);
+		const size_t pageSize = sysInfo.dwPageSize;
+
+		mappedSize = static_cast<size_t>(fileSize.QuadPart);
+		pageSlack = (pageSize - (mappedSize % pageSize)) % pageSize;
+		copyOnWrite = a_copyOnWrite;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (mappedData != nullptr) {
+			UnmapViewOfFile(mappedData);
+			mappedData = nullptr;
+		}
+
+		if (mappingHandle != NULL) {
+			CloseHandle(mappingHandle);
+			mappingHandle = NULL;
+		}
+
+		if (fileHandle != INVALID_HANDLE_VALUE) {
+			CloseHandle(fileHandle);
+			fileHandle = INVALID_HANDLE_VALUE;
+		}
+
+		mappedSize = 0;
+		pageSlack = 0;
+		copyOnWrite = false;
+	}
+
+	const uint8_t* MappedFile::data() const
+	{
+		return mappedData;
+	}
+
+	size_t MappedFile::size() const
+	{
+		return mappedSize;
+	}
+
+	std::span<const uint8_t> MappedFile::view() const
+	{
+		return { mappedData, mappedSize };
+	}
+
+	std::span<uint8_t> MappedFile::writableView()
+	{
+		if (!copyOnWrite)
+			return {};
+
+		return { mappedData, mappedSize + pageSlack };
+	}
+
+	size_t MappedFile::slack() const
+	{
+		return pageSlack;
+	}
+}
\ No newline at end of file
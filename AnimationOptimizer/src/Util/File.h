@@ -0,0 +1,65 @@
+#pragma once
+
+namespace Util::File
+{
+	enum class Format : uint8_t
+	{
+		kUnknown,
+		kGLB,
+		kJSON,
+		kGzip,
+		kZlib,
+		kZstd
+	};
+
+	Format DetectFormat(const std::span<const uint8_t> a_header);
+	bool IsCompressed(Format a_format);
+
+	//Inflates a gzip or zlib stream into a_output, sized once from the gzip ISIZE trailer when available.
+	//a_padding zeroed bytes are left past the decompressed data. Returns the decompressed size, or 0 on failure.
+	size_t Inflate(const std::span<const uint8_t> a_input, Format a_format, std::vector<uint8_t>& a_output, size_t a_padding = 0);
+
+	//Decompresses a zstd stream into a_output with the same padding & return conventions as Inflate.
+	//a_dictionary is only used for frames that were compressed with a dictionary.
+	size_t DecompressZstd(const std::span<const uint8_t> a_input, std::vector<uint8_t>& a_output, size_t a_padding = 0, const std::span<const uint8_t> a_dictionary = {});
+
+	//Inflate or DecompressZstd, depending on a_format.
+	size_t Decompress(const std::span<const uint8_t> a_input, Format a_format, std::vector<uint8_t>& a_output, size_t a_padding = 0, const std::span<const uint8_t> a_dictionary = {});
+
+	//Compresses a_input as a single zstd frame carrying its content size & a checksum. Returns false on failure.
+	bool CompressZstd(const std::span<const uint8_t> a_input, int a_level, std::vector<uint8_t>& a_output, const std::span<const uint8_t> a_dictionary = {});
+
+	//Trains a zstd dictionary of at most a_capacity bytes from a_samples. Returns an empty vector on failure.
+	std::vector<uint8_t> TrainZstdDictionary(const std::vector<std::vector<uint8_t>>& a_samples, size_t a_capacity);
+
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		~MappedFile();
+
+		//a_copyOnWrite maps the file with private, copy-on-write pages: writes never reach the file, and only touched pages get copied.
+		bool Open(const std::filesystem::path& a_path, bool a_copyOnWrite = false);
+		void Close();
+
+		const uint8_t* data() const;
+		size_t size() const;
+		std::span<const uint8_t> view() const;
+
+		//The mapping including its slack, empty unless the file was opened copy-on-write.
+		std::span<uint8_t> writableView();
+
+		//Number of zero-filled, readable bytes between the end of the file and the end of its last mapped page.
+		size_t slack() const;
+
+	private:
+		HANDLE fileHandle = INVALID_HANDLE_VALUE;
+		HANDLE mappingHandle = NULL;
+		uint8_t* mappedData = nullptr;
+		size_t mappedSize = 0;
+		size_t pageSlack = 0;
+		bool copyOnWrite = false;
+	};
+}
\ No newline at end of file
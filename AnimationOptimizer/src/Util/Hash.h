@@ -0,0 +1,45 @@
+#pragma once
+
+namespace Util::Hash
+{
+	//Fast, non-cryptographic 64-bit hash using xxHash64-style mixing over 8-byte lanes.
+	inline uint64_t Hash64(const void* a_data, size_t a_size, uint64_t a_seed = 0)
+	{
+		constexpr uint64_t prime1 = 0x9E3779B185EBCA87ull;
+		constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+		constexpr uint64_t prime3 = 0x165667B19E3779F9ull;
+		constexpr uint64_t prime4 = 0x85EBCA77C2B2AE63ull;
+		constexpr uint64_t prime5 = 0x27D4EB2F165667C5ull;
+
+		const uint8_t* bytes = static_cast<const uint8_t*>(a_data);
+		uint64_t h = a_seed + prime5 + static_cast<uint64_t>(a_size);
+
+		size_t i = 0;
+		for (; i + 8 <= a_size; i += 8) {
+			uint64_t k;
+			std::memcpy(&k, bytes + i, sizeof(k));
+			k *= prime2;
+			k = std::rotl(k, 31);
+			k *= prime1;
+			h ^= k;
+			h = std::rotl(h, 27) * prime1 + prime4;
+		}
+
+		for (; i < a_size; i++) {
+			h ^= static_cast<uint64_t>(bytes[i]) * prime5;
+			h = std::rotl(h, 11) * prime1;
+		}
+
+		h ^= h >> 33;
+		h *= prime2;
+		h ^= h >> 29;
+		h *= prime3;
+		h ^= h >> 32;
+		return h;
+	}
+
+	inline uint64_t Combine(uint64_t a_hash, uint64_t a_value)
+	{
+		return Hash64(&a_value, sizeof(a_value), a_hash);
+	}
+}
\ No newline at end of file
@@ -1,160 +1,625 @@
 #include "Serialization/GLTFImport.h"
 #include "Serialization/GLTFExport.h"
+#include "Serialization/OzzCache.h"
+#include "Serialization/OutputCache.h"
+#include "Serialization/ExportBenchmark.h"
 #include "Settings/Settings.h"
+#include "Animation/Resample.h"
+#include "Util/File.h"
 #include "zstr.hpp"
 
-DLLEXPORT bool OptimizeAnimation(const char* filePath, const char* skeletonPath, int level, bool additive)
+namespace
 {
-	uint8_t shortLevel = static_cast<uint8_t>(std::clamp(level, 0, 255));
+	//Per-clip result codes reported by the batch export.
+	enum class OptimizeStatus : int
+	{
+		kSuccess = 0,
+		kSkeletonFailed = 1,
+		kLoadFailed = 2,
+		kConvertFailed = 3,
+		kAdditiveFailed = 4,
+		kExportFailed = 5,
+		kWriteFailed = 6,
+		kOverridesFailed = 7
+	};
+
+	//The morph table never changes, so it is built once per process rather than on every call.
+	void InitFaceMorphs()
+	{
+		static std::once_flag once;
+		std::call_once(once, [] {
+			Settings::SetFaceMorphs({
+				"browLowererL",
+				"browLowererR",
+				"cheekPuffL",
+				"cheekPuffR",
+				"cheekRaiseL",
+				"cheekRaiseR",
+				"cheekSuckL",
+				"cheekSuckR",
+				"chinRaise",
+				"chinRaiseUpperlipTweak",
+				"c_eyeDown_eyeClosedL",
+				"c_eyeDown_eyeClosedR",
+				"c_eyeLeft_eyeClosedL",
+				"c_eyeLeft_eyeClosedR",
+				"c_eyeRight_eyeClosedL",
+				"c_eyeRight_eyeClosedR",
+				"c_eyeUp_eyeClosedL",
+				"c_eyeUp_eyeClosedR",
+				"c_eyesClosed50L",
+				"c_eyesClosed50R",
+				"c_jawDrop",
+				"c_squintL_cheekRaiserL",
+				"c_squintR_cheekRaiserR",
+				"dimplerL",
+				"dimplerR",
+				"eyeClosedL",
+				"eyeClosedR",
+				"eyeDown",
+				"eyeLeft",
+				"eyeOpenL",
+				"eyeOpenR",
+				"eyeRight",
+				"eyeUp",
+				"innerBrowRaiseL",
+				"innerBrowRaiseR",
+				"jawClench",
+				"jawLeft",
+				"jawOpen",
+				"jawRight",
+				"jawThrust",
+				"lidTightenerL",
+				"lidTightenerR",
+				"lipCornerDepressL",
+				"lipCornerDepressR",
+				"lipCornerInL",
+				"lipCornerInR",
+				"lipCornerPullL",
+				"lipCornerPullR",
+				"lipPress",
+				"lipPucker",
+				"lipStretchL",
+				"lipStretchR",
+				"lipTighten",
+				"lipZipperL",
+				"lipZipperR",
+				"lowerLipDepressL",
+				"lowerLipDepressR",
+				"lowerLipFunnel",
+				"lowerLipPuff",
+				"lowerLipSuck",
+				"lowerLipThickness",
+				"lowerLipUpL",
+				"lowerLipUpR",
+				"nasolabialFurrowL",
+				"nasolabialFurrowR",
+				"neckFlexL",
+				"neckFlexR",
+				"noseDepressor",
+				"noseWrinkleL",
+				"noseWrinkleR",
+				"nostrilCompressor",
+				"nostrilDilator",
+				"outerBrowRaiseL",
+				"outerBrowRaiseR",
+				"sharpLipPullL",
+				"sharpLipPullR",
+				"squintL",
+				"squintR",
+				"swallow",
+				"upperLipDownL",
+				"upperLipDownR",
+				"upperLipFunnel",
+				"upperLipPuff",
+				"upperLipRaiseL",
+				"upperLipRaiseR",
+				"upperLipSuck",
+				"upperLipThickness",
+				"tongueCurlDown",
+				"tongueCurlUp",
+				"tongueDown",
+				"tongueUp",
+				"tongueIn",
+				"tongueOut",
+				"tongueLeft",
+				"tongueRight",
+				"tongueThick",
+				"tongueThinner",
+				"LookDown",
+				"LookUp",
+				"LookRight",
+				"LookLeft",
+				"Hat",
+				"HideEar",
+				"Mask"
+			});
+		});
+	}
+
+	//status receives kSkeletonFailed or kOverridesFailed when this returns null.
+	std::unique_ptr<Serialization::GLTFImport::SkeletonData> LoadSkeleton(const char* skeletonPath, OptimizeStatus& status)
+	{
+		status = OptimizeStatus::kSkeletonFailed;
+		auto skeleFile = Serialization::GLTFImport::LoadGLTF(skeletonPath);
+		if (!skeleFile) {
+			return nullptr;
+		}
+
+		auto skeleData = Serialization::GLTFImport::BuildSkeleton(skeleFile.get());
+		if (!skeleData || !skeleData->skeleton) {
+			return nullptr;
+		}
+
+		//Optional per-joint optimizer settings. A sidecar that exists but can't be parsed fails the load,
+		//otherwise the export would quietly run with the global settings.
+		if (!skeleData->overrides.Load(Animation::JointOverrides::GetSidecarPath(skeletonPath))) {
+			status = OptimizeStatus::kOverridesFailed;
+			return nullptr;
+		}
+
+		status = OptimizeStatus::kSuccess;
+		return skeleData;
+	}
+
+	//Copies text into a caller-provided buffer, truncated to bufferSize including the terminator.
+	void CopyToBuffer(const std::string& text, char* buffer, int bufferSize)
+	{
+		if (buffer == nullptr || bufferSize <= 0) {
+			return;
+		}
+
+		const size_t count = std::min(text.size(), static_cast<size_t>(bufferSize) - 1);
+		std::memcpy(buffer, text.data(), count);
+		buffer[count] = '\0';
+	}
+
+	//Lifetime peak of the host process, which includes whatever it did before loading this library.
+	size_t GetHostPeakWorkingSet()
+	{
+		PROCESS_MEMORY_COUNTERS pmc;
+		if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+			return 0;
+		}
+		return pmc.PeakWorkingSetSize;
+	}
+
+	//zstd when a level is set, otherwise the zlib stream the plugin has always read.
+	bool WriteOutput(const char* outputPath, std::vector<std::byte>& data)
+	{
+		try {
+			if (int zstdLevel = Settings::GetZstdLevel(); zstdLevel > 0) {
+				std::vector<uint8_t> compressed;
+				const std::span<const uint8_t> input{ reinterpret_cast<const uint8_t*>(data.data()), data.size() };
+				if (!Util::File::CompressZstd(input, zstdLevel, compressed, Settings::GetZstdDictionary()))
+					return false;
+
+				std::ofstream file(outputPath, std::ios::binary | std::ios::trunc);
+				file.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+				return file.good();
+			}
+
+			zstr::ofstream file(outputPath, std::ios::binary);
+			file.write(reinterpret_cast<char*>(data.data()), data.size());
+			return true;
+		} catch (const std::exception&) {
+			return false;
+		}
+	}
+
+	//Builds the runtime cache from the written file rather than the in-memory clip, so quantized rotations & elided tracks
+	//come out exactly as any other loader of the GLB would see them.
+	bool WriteRuntimeCache(const char* outputPath, const Serialization::GLTFImport::SkeletonData* skeleData)
+	{
+		auto outputFile = Serialization::GLTFImport::LoadGLTF(outputPath);
+		if (!outputFile || outputFile->asset.animations.empty()) {
+			return false;
+		}
+
+		auto decoded = Serialization::GLTFImport::CreateRawAnimation(outputFile.get(), &outputFile->asset.animations[0], skeleData->skeleton.get(), &skeleData->jointMap);
+		if (!decoded) {
+			return false;
+		}
+
+		if (!Serialization::OzzCache::Write(outputPath, decoded.get(), skeleData->skeleton.get())) {
+			return false;
+		}
+
+		//Read it back, so a file the loader would reject or misread is never left next to the output.
+		auto cached = Serialization::OzzCache::Load(outputPath, skeleData->skeleton.get());
+		const size_t faceCount = decoded->faceData != nullptr ? decoded->faceData->tracks.size() : 0;
+		if (!cached ||
+			cached->animation->num_tracks() != decoded->data->num_tracks() ||
+			cached->animation->duration() != decoded->data->duration ||
+			cached->faceTracks.size() != faceCount) {
+			std::error_code ec;
+			std::filesystem::remove(Serialization::OzzCache::GetCachePath(outputPath), ec);
+			return false;
+		}
+		return true;
+	}
+
+	//Runs an imported clip through resampling, the additive conversion & the export, and writes the result to outputPath.
+	//parallel spreads the clip's work over the thread pool. Callers that run whole clips in parallel pass false.
+	OptimizeStatus OptimizeClip(Animation::RawOzzAnimation* rawAnim, const char* outputPath, const Serialization::GLTFImport::SkeletonData* skeleData, uint8_t level, bool additive, bool parallel, Serialization::GLTFExport::ExportStats* stats = nullptr)
+	{
+		if (float rate = Settings::GetResampleRate(); rate > 0.0f) {
+			Animation::ResampleAnimation(rawAnim, rate, parallel);
+		}
+
+		if (additive) {
+			ozz::animation::offline::AdditiveAnimationBuilder addBuilder;
+			auto addResult = ozz::make_unique<ozz::animation::offline::RawAnimation>();
+			if (!addBuilder(*rawAnim->data, ozz::make_span(skeleData->restPose), addResult.get())) {
+				return OptimizeStatus::kAdditiveFailed;
+			}
+			rawAnim->data = std::move(addResult);
+		}
+
+		auto optimizedAsset = Serialization::GLTFExport::CreateOptimizedAsset(rawAnim, skeleData->skeleton.get(), level, &skeleData->overrides, stats, skeleData->parents);
+		if (optimizedAsset.empty()) {
+			return OptimizeStatus::kExportFailed;
+		}
+
+		if (!WriteOutput(outputPath, optimizedAsset)) {
+			return OptimizeStatus::kWriteFailed;
+		}
+
+		//The cache is an accelerator only, the optimized GLB is already written if it fails.
+		if (Settings::GetWriteRuntimeCache()) {
+			WriteRuntimeCache(outputPath, skeleData);
+		}
+
+		return OptimizeStatus::kSuccess;
+	}
+
+	//stats, if given, is filled in for the optimize & export steps plus the import time.
+	//configHash comes from OutputCache::HashConfig and cacheKey from OutputCache::GetKey, which the caller has already
+	//checked for a hit. It must be taken before anything is written, since outputPath may be the input. 0 skips the output cache.
+	OptimizeStatus OptimizeFile(const char* inputPath, const char* outputPath, const Serialization::GLTFImport::SkeletonData* skeleData, uint8_t level, bool additive, uint64_t configHash, uint64_t cacheKey, bool parallel, Serialization::GLTFExport::ExportStats* stats = nullptr)
+	{
+		auto importStart = std::chrono::steady_clock::now();
+		auto baseFile = Serialization::GLTFImport::LoadGLTF(inputPath);
+		if (!baseFile || baseFile->asset.animations.empty()) {
+			return OptimizeStatus::kLoadFailed;
+		}
+
+		auto rawAnim = Serialization::GLTFImport::CreateRawAnimation(baseFile.get(), &baseFile->asset.animations[0], skeleData->skeleton.get(), &skeleData->jointMap, parallel);
+		if (!rawAnim) {
+			return OptimizeStatus::kConvertFailed;
+		}
+
+		baseFile.reset();
+		const double importMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - importStart).count();
+
+		const OptimizeStatus status = OptimizeClip(rawAnim.get(), outputPath, skeleData, level, additive, parallel, stats);
+		if (stats != nullptr) {
+			stats->importMs = importMs;
+		}
+		if (status != OptimizeStatus::kSuccess) {
+			return status;
+		}
+
+		if (cacheKey != 0) {
+			Serialization::OutputCache::Store(cacheKey, outputPath);
+
+			//An input optimized in place is replaced by its output, so key the output too or the next run would miss.
+			std::error_code ec;
+			if (std::filesystem::equivalent(inputPath, outputPath, ec)) {
+				Serialization::OutputCache::Store(Serialization::OutputCache::GetKey(configHash, outputPath), outputPath);
+			}
+		}
+
+		return OptimizeStatus::kSuccess;
+	}
+
+	//Clip names become file names, so anything Windows won't accept in one is replaced.
+	std::string MakeClipFileName(std::string_view clipName, const std::filesystem::path& inputPath, size_t index)
+	{
+		std::string result;
+		for (char c : clipName) {
+			const bool invalid = static_cast<unsigned char>(c) < 32 || std::string_view("<>:\"/\\|?*").find(c) != std::string_view::npos;
+			result.push_back(invalid ? '_' : c);
+		}
+
+		while (!result.empty() && (result.back() == '.' || result.back() == ' ')) {
+			result.pop_back();
+		}
+
+		if (result.empty()) {
+			result = std::format("{}_{}", inputPath.stem().string(), index);
+		}
+		return result + ".glb";
+	}
+}
+
+
+DLLEXPORT void SetResampleRate(float frameRate)
+{
+	Settings::SetResampleRate(frameRate);
+}
+
+DLLEXPORT void SetElideConstantTracks(bool elide)
+{
+	Settings::SetElideConstantTracks(elide);
+}
+
+//Writes rotations as normalized int16, which core glTF allows. Off by default: only enable it once the runtime loader
+//decodes normalized rotation accessors, since it currently expects floats.
+DLLEXPORT void SetQuantizeRotations(bool quantize)
+{
+	Settings::SetQuantizeRotations(quantize);
+}
+
+DLLEXPORT void SetWriteRuntimeCache(bool write)
+{
+	Settings::SetWriteRuntimeCache(write);
+}
 
-	Settings::SetFaceMorphs({
-		"browLowererL",
-		"browLowererR",
-		"cheekPuffL",
-		"cheekPuffR",
-		"cheekRaiseL",
-		"cheekRaiseR",
-		"cheekSuckL",
-		"cheekSuckR",
-		"chinRaise",
-		"chinRaiseUpperlipTweak",
-		"c_eyeDown_eyeClosedL",
-		"c_eyeDown_eyeClosedR",
-		"c_eyeLeft_eyeClosedL",
-		"c_eyeLeft_eyeClosedR",
-		"c_eyeRight_eyeClosedL",
-		"c_eyeRight_eyeClosedR",
-		"c_eyeUp_eyeClosedL",
-		"c_eyeUp_eyeClosedR",
-		"c_eyesClosed50L",
-		"c_eyesClosed50R",
-		"c_jawDrop",
-		"c_squintL_cheekRaiserL",
-		"c_squintR_cheekRaiserR",
-		"dimplerL",
-		"dimplerR",
-		"eyeClosedL",
-		"eyeClosedR",
-		"eyeDown",
-		"eyeLeft",
-		"eyeOpenL",
-		"eyeOpenR",
-		"eyeRight",
-		"eyeUp",
-		"innerBrowRaiseL",
-		"innerBrowRaiseR",
-		"jawClench",
-		"jawLeft",
-		"jawOpen",
-		"jawRight",
-		"jawThrust",
-		"lidTightenerL",
-		"lidTightenerR",
-		"lipCornerDepressL",
-		"lipCornerDepressR",
-		"lipCornerInL",
-		"lipCornerInR",
-		"lipCornerPullL",
-		"lipCornerPullR",
-		"lipPress",
-		"lipPucker",
-		"lipStretchL",
-		"lipStretchR",
-		"lipTighten",
-		"lipZipperL",
-		"lipZipperR",
-		"lowerLipDepressL",
-		"lowerLipDepressR",
-		"lowerLipFunnel",
-		"lowerLipPuff",
-		"lowerLipSuck",
-		"lowerLipThickness",
-		"lowerLipUpL",
-		"lowerLipUpR",
-		"nasolabialFurrowL",
-		"nasolabialFurrowR",
-		"neckFlexL",
-		"neckFlexR",
-		"noseDepressor",
-		"noseWrinkleL",
-		"noseWrinkleR",
-		"nostrilCompressor",
-		"nostrilDilator",
-		"outerBrowRaiseL",
-		"outerBrowRaiseR",
-		"sharpLipPullL",
-		"sharpLipPullR",
-		"squintL",
-		"squintR",
-		"swallow",
-		"upperLipDownL",
-		"upperLipDownR",
-		"upperLipFunnel",
-		"upperLipPuff",
-		"upperLipRaiseL",
-		"upperLipRaiseR",
-		"upperLipSuck",
-		"upperLipThickness",
-		"tongueCurlDown",
-		"tongueCurlUp",
-		"tongueDown",
-		"tongueUp",
-		"tongueIn",
-		"tongueOut",
-		"tongueLeft",
-		"tongueRight",
-		"tongueThick",
-		"tongueThinner",
-		"LookDown",
-		"LookUp",
-		"LookRight",
-		"LookLeft",
-		"Hat",
-		"HideEar",
-		"Mask"
+//Levels 1 and up binary-search the optimizer tolerance for the smallest output within errorCm of the source,
+//measured at sampleCount uniform times. 0 goes back to the fixed per-level tolerances.
+DLLEXPORT void SetTargetError(float errorCm, int sampleCount)
+{
+	Settings::SetTargetError(errorCm, static_cast<uint32_t>(std::max(sampleCount, 0)));
+}
+
+//Max weight error allowed when reducing face morph tracks at levels 2 and up. Level 1 only drops redundant keys.
+DLLEXPORT void SetMorphTolerance(float tolerance)
+{
+	Settings::SetMorphTolerance(tolerance);
+}
+
+//level > 0 writes optimized clips as zstd at that level instead of zlib, 0 goes back to zlib.
+//dictionaryPath may be null or empty to compress without a dictionary. The same dictionary is used to read
+//dictionary-compressed inputs. Returns false if the dictionary can't be read, leaving the settings unchanged.
+DLLEXPORT bool SetZstdCompression(int level, const char* dictionaryPath)
+{
+	std::vector<uint8_t> dictionary;
+	if (dictionaryPath != nullptr && dictionaryPath[0] != '\0') {
+		Util::File::MappedFile file;
+		if (!file.Open(dictionaryPath))
+			return false;
+
+		dictionary.assign(file.data(), file.data() + file.size());
+	}
+
+	Settings::SetZstdLevel(level);
+	Settings::SetZstdDictionary(std::move(dictionary));
+	return true;
+}
+
+//Trains a zstd dictionary of at most capacity bytes from a set of clips and writes it to outputPath.
+//Compressed clips are decompressed first, so existing optimized files make a good corpus.
+DLLEXPORT bool TrainZstdDictionary(const char** samplePaths, int count, const char* outputPath, int capacity)
+{
+	if (samplePaths == nullptr || count <= 0 || outputPath == nullptr || capacity <= 0) {
+		return false;
+	}
+
+	std::vector<std::vector<uint8_t>> samples(count);
+	std::vector<size_t> idxs(count);
+	std::iota(idxs.begin(), idxs.end(), 0);
+	std::for_each(std::execution::par, idxs.begin(), idxs.end(), [&](size_t i) {
+		Util::File::MappedFile file;
+		if (samplePaths[i] == nullptr || !file.Open(samplePaths[i]))
+			return;
+
+		auto format = Util::File::DetectFormat(file.view().first(std::min<size_t>(file.size(), 16)));
+		if (Util::File::IsCompressed(format)) {
+			Util::File::Decompress(file.view(), format, samples[i], 0, Settings::GetZstdDictionary());
+		} else {
+			samples[i].assign(file.data(), file.data() + file.size());
+		}
 	});
 
-	auto skeleFile = Serialization::GLTFImport::LoadGLTF(skeletonPath);
-	if (!skeleFile) {
+	auto dictionary = Util::File::TrainZstdDictionary(samples, static_cast<size_t>(capacity));
+	if (dictionary.empty()) {
 		return false;
 	}
 
-	auto skeleData = Serialization::GLTFImport::BuildSkeleton(skeleFile.get());
-	if (!skeleData || !skeleData->skeleton) {
+	try {
+		std::ofstream file(outputPath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(dictionary.data()), dictionary.size());
+		return file.good();
+	} catch (const std::exception&) {
 		return false;
 	}
+}
 
-	skeleFile.reset();
+//Directory for the content-addressed output cache. OptimizeAnimation & OptimizeAnimations copy a previous result
+//from it when the input, skeleton and settings all match. Null or empty disables the cache.
+DLLEXPORT void SetOutputCacheDirectory(const char* directory)
+{
+	Settings::SetOutputCacheDirectory(directory != nullptr ? std::filesystem::path(directory) : std::filesystem::path());
+}
 
-	auto baseFile = Serialization::GLTFImport::LoadGLTF(filePath);
-	if (!baseFile || baseFile->asset.animations.empty()) {
-		return false;
+DLLEXPORT bool OptimizeAnimation(const char* filePath, const char* skeletonPath, int level, bool additive)
+{
+	uint8_t shortLevel = static_cast<uint8_t>(std::clamp(level, 0, 255));
+	InitFaceMorphs();
+
+	//The cache is keyed on the skeleton's bytes, so a hit returns without parsing it.
+	const uint64_t configHash = Serialization::OutputCache::HashConfig(skeletonPath, shortLevel, additive);
+	const uint64_t cacheKey = Serialization::OutputCache::GetKey(configHash, filePath);
+	if (Serialization::OutputCache::Restore(cacheKey, filePath)) {
+		return true;
 	}
 
-	auto rawAnim = Serialization::GLTFImport::CreateRawAnimation(baseFile.get(), &baseFile->asset.animations[0], skeleData->skeleton.get());
-	if (!rawAnim) {
+	OptimizeStatus skeleStatus;
+	auto skeleData = LoadSkeleton(skeletonPath, skeleStatus);
+	if (!skeleData) {
 		return false;
 	}
 
+	return OptimizeFile(filePath, filePath, skeleData.get(), shortLevel, additive, configHash, cacheKey, true) == OptimizeStatus::kSuccess;
+}
+
+//Same as OptimizeAnimation, but writes a JSON report of the run into jsonBuffer, truncated to bufferSize including the terminator.
+//The report holds the OptimizeStatus plus key counts, accessor bytes, dedupe hits, timings and the host process's peak working set.
+DLLEXPORT bool OptimizeAnimationWithStats(const char* filePath, const char* skeletonPath, int level, bool additive, char* jsonBuffer, int bufferSize)
+{
+	uint8_t shortLevel = static_cast<uint8_t>(std::clamp(level, 0, 255));
+	InitFaceMorphs();
+
+	Serialization::GLTFExport::ExportStats stats;
+	OptimizeStatus status;
+	auto skeleData = LoadSkeleton(skeletonPath, status);
+	if (skeleData) {
+		//A cache hit would leave the report empty, so this always optimizes.
+		status = OptimizeFile(filePath, filePath, skeleData.get(), shortLevel, additive, 0, 0, true, &stats);
+	}
+	stats.hostPeakWorkingSetBytes = GetHostPeakWorkingSet();
+
+	CopyToBuffer(std::format(R"({{"status":{},"stats":{}}})", static_cast<int>(status), stats.ToJson()), jsonBuffer, bufferSize);
+
+	return status == OptimizeStatus::kSuccess;
+}
+
+//Optimizes the animations in one GLB from a single parse, writing each clip to outputDirectory as <clip name>.glb.
+//clipNames may be null to optimize every animation, otherwise only the clipCount named ones are parsed & optimized, and a
+//name that isn't in the file reports kLoadFailed. Unnamed clips are written as <input name>_<index>.glb, and names that
+//would collide get _<index> appended. statuses, if given, receives an OptimizeStatus per clip, in clipNames order or else
+//file order, for at most statusCount clips. Clips are processed concurrently, and the output cache isn't used.
+//Returns the number of clips written, or -1 if the skeleton, its overrides sidecar or the file couldn't be loaded, or if
+//none of clipNames are in the file.
+DLLEXPORT int OptimizeAnimationClips(const char* filePath, const char* outputDirectory, const char* skeletonPath, int level, bool additive, const char** clipNames, int clipCount, int* statuses, int statusCount)
+{
+	if (filePath == nullptr || outputDirectory == nullptr) {
+		return -1;
+	}
+
+	std::vector<std::string_view> names;
+	if (clipNames != nullptr) {
+		for (int i = 0; i < clipCount; i++) {
+			names.emplace_back(clipNames[i] != nullptr ? clipNames[i] : "");
+		}
+		if (names.empty()) {
+			return 0;
+		}
+	}
+
+	uint8_t shortLevel = static_cast<uint8_t>(std::clamp(level, 0, 255));
+	InitFaceMorphs();
+
+	OptimizeStatus skeleStatus;
+	auto skeleData = LoadSkeleton(skeletonPath, skeleStatus);
+	if (!skeleData) {
+		return -1;
+	}
+
+	//A selective load when names are given, so clips that aren't asked for are never decoded.
+	auto baseFile = Serialization::GLTFImport::LoadGLTF(filePath, names);
+	if (!baseFile || baseFile->asset.animations.empty()) {
+		return -1;
+	}
+
+	auto rawAnims = Serialization::GLTFImport::CreateRawAnimations(baseFile.get(), skeleData->skeleton.get(), names, &skeleData->jointMap, true);
+
+	//Windows file names are case-insensitive, so clips whose names only differ in case would overwrite each other.
+	std::vector<std::string> outputPaths(rawAnims.size());
+	std::set<std::string> usedNames;
+	const auto Claim = [&](const std::string& fileName) {
+		std::string lowerName = fileName;
+		std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+		return usedNames.insert(std::move(lowerName)).second;
+	};
+
+	for (size_t i = 0; i < rawAnims.size(); i++) {
+		std::string fileName = MakeClipFileName(names.empty() ? std::string_view(baseFile->asset.animations[i].name) : names[i], filePath, i);
+		//The fallback is claimed too, so a later clip actually named <name>_<index> can't take it, and may itself collide.
+		const std::string stem = std::filesystem::path(fileName).stem().string();
+		for (size_t n = 1; !Claim(fileName); n++) {
+			fileName = MakeClipFileName(n == 1 ? std::format("{}_{}", stem, i) : std::format("{}_{}_{}", stem, i, n), filePath, i);
+		}
+		outputPaths[i] = (std::filesystem::path(outputDirectory) / fileName).string();
+	}
+
+	std::vector<OptimizeStatus> results(rawAnims.size(), OptimizeStatus::kConvertFailed);
+	auto& animations = baseFile->asset.animations;
+	for (size_t i = 0; i < names.size(); i++) {
+		if (std::none_of(animations.begin(), animations.end(), [&](const fastgltf::Animation& a) { return a.name == names[i]; })) {
+			results[i] = OptimizeStatus::kLoadFailed;
+		}
+	}
 	baseFile.reset();
 
-	if (additive) {
-		ozz::animation::offline::AdditiveAnimationBuilder addBuilder;
-		auto addResult = ozz::make_unique<ozz::animation::offline::RawAnimation>();
-		if (!addBuilder(*rawAnim->data, ozz::make_span(skeleData->restPose), addResult.get())) {
-			return false;
+	std::error_code ec;
+	std::filesystem::create_directories(outputDirectory, ec);
+
+	std::vector<size_t> idxs(rawAnims.size());
+	std::iota(idxs.begin(), idxs.end(), 0);
+	std::for_each(std::execution::par, idxs.begin(), idxs.end(), [&](size_t i) {
+		if (rawAnims[i]) {
+			results[i] = OptimizeClip(rawAnims[i].get(), outputPaths[i].c_str(), skeleData.get(), shortLevel, additive, false);
+		}
+	});
+
+	if (statuses != nullptr) {
+		const size_t count = std::min(results.size(), static_cast<size_t>(std::max(statusCount, 0)));
+		for (size_t i = 0; i < count; i++) {
+			statuses[i] = static_cast<int>(results[i]);
 		}
-		rawAnim->data = std::move(addResult);
 	}
 
-	auto optimizedAsset = Serialization::GLTFExport::CreateOptimizedAsset(rawAnim.get(), skeleData->skeleton.get(), shortLevel);
+	return static_cast<int>(std::count(results.begin(), results.end(), OptimizeStatus::kSuccess));
+}
 
-	try {
-		zstr::ofstream file(filePath, std::ios::binary);
-		file.write(reinterpret_cast<char*>(optimizedAsset.data()), optimizedAsset.size());
-	} catch (const std::exception&) {
+//Optimizes count clips against one skeleton, which is loaded once. Clips are processed concurrently.
+//outputPaths may be null to overwrite the inputs. statuses, if given, receives an OptimizeStatus per clip.
+//Returns true only if every clip succeeded.
+DLLEXPORT bool OptimizeAnimations(const char** inputPaths, const char** outputPaths, int count, const char* skeletonPath, int level, bool additive, int* statuses)
+{
+	if (inputPaths == nullptr || count <= 0) {
 		return false;
 	}
 
-	return true;
+	uint8_t shortLevel = static_cast<uint8_t>(std::clamp(level, 0, 255));
+	InitFaceMorphs();
+
+	auto getOutputPath = [&](size_t i) {
+		return (outputPaths != nullptr && outputPaths[i] != nullptr) ? outputPaths[i] : inputPaths[i];
+	};
+
+	//Cache hits are restored first, so the skeleton is only parsed if something is left to optimize.
+	const uint64_t configHash = Serialization::OutputCache::HashConfig(skeletonPath, shortLevel, additive);
+	std::vector<uint64_t> cacheKeys(count);
+	std::vector<OptimizeStatus> results(count, OptimizeStatus::kSkeletonFailed);
+	std::vector<size_t> idxs(count);
+	std::iota(idxs.begin(), idxs.end(), 0);
+	std::for_each(std::execution::par, idxs.begin(), idxs.end(), [&](size_t i) {
+		cacheKeys[i] = Serialization::OutputCache::GetKey(configHash, inputPaths[i]);
+		if (Serialization::OutputCache::Restore(cacheKeys[i], getOutputPath(i))) {
+			results[i] = OptimizeStatus::kSuccess;
+		}
+	});
+
+	std::erase_if(idxs, [&](size_t i) { return results[i] == OptimizeStatus::kSuccess; });
+	if (!idxs.empty()) {
+		OptimizeStatus skeleStatus;
+		auto skeleData = LoadSkeleton(skeletonPath, skeleStatus);
+		std::for_each(std::execution::par, idxs.begin(), idxs.end(), [&](size_t i) {
+			results[i] = skeleData ? OptimizeFile(inputPaths[i], getOutputPath(i), skeleData.get(), shortLevel, additive, configHash, cacheKeys[i], false) : skeleStatus;
+		});
+	}
+
+	if (statuses != nullptr) {
+		for (int i = 0; i < count; i++) {
+			statuses[i] = static_cast<int>(results[i]);
+		}
+	}
+
+	return std::all_of(results.begin(), results.end(), [](OptimizeStatus s) { return s == OptimizeStatus::kSuccess; });
+}
+
+//Exports synthetic clips on skeletons of a quarter, half and all of jointCount joints, and writes the timings as JSON to jsonBuffer.
+//See Serialization::ExportBenchmark. Returns false if the synthetic skeleton couldn't be built.
+DLLEXPORT bool BenchmarkExport(int jointCount, int keysPerTrack, int iterations, char* jsonBuffer, int bufferSize)
+{
+	std::string json = Serialization::ExportBenchmark::Run(
+		static_cast<size_t>(std::max(jointCount, 0)),
+		static_cast<size_t>(std::max(keysPerTrack, 0)),
+		static_cast<size_t>(std::max(iterations, 0)));
+
+	CopyToBuffer(json, jsonBuffer, bufferSize);
+	return !json.empty();
 }
\ No newline at end of file
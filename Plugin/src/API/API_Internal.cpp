@@ -83,6 +83,21 @@ namespace
 		}
 	};
 
+	//Views a skeleton's joint names directly, holding a reference to the skeleton so the names outlive the handle.
+	struct NAFAPI_JointNameArray
+	{
+		std::shared_ptr<const void> owner;
+		std::vector<const char*> charPtrs;
+
+		operator NAFAPI_Array<const char*>()
+		{
+			NAFAPI_Array<const char*> result;
+			result.data = charPtrs.data();
+			result.size = charPtrs.size();
+			return result;
+		}
+	};
+
 	class NAFAPI_SharedObject
 	{
 	public:
@@ -152,12 +167,10 @@ NAFAPI_Handle<NAFAPI_Array<const char*>> NAFAPI_GetSkeletonNodes(
 	if (Settings::IsDefaultSkeleton(skeleton))
 		return result;
 
-	auto obj = std::make_unique<NAFAPI_Shared<NAFAPI_StringArray>>();
-	std::vector<std::string> namesArr;
-	for (auto& n : skeleton->data->joint_names()) {
-		namesArr.push_back(n);
-	}
-	obj->data = namesArr;
+	auto obj = std::make_unique<NAFAPI_Shared<NAFAPI_JointNameArray>>();
+	auto jointNames = skeleton->data->joint_names();
+	obj->data.charPtrs.assign(jointNames.begin(), jointNames.end());
+	obj->data.owner = skeleton;
 	result.data = obj->data;
 	result.handle = MakeObjectManaged(std::move(obj));
 	return result;
@@ -35,7 +35,7 @@ namespace Commands::NAFCommand
 		itfc->PrintLn("naf stop <optional: actor_form_id>");
 		itfc->PrintLn("naf sync <actor_form_id> <actor_form_id> <any # more...>");
 		itfc->PrintLn("naf stopsync <optional: actor_form_id>");
-		itfc->PrintLn("naf optimize <file_path> <optional: actor_form_id>");
+		itfc->PrintLn("naf optimize <file_path> <level | test | test:<levels,...>> <optional: actor_form_id>");
 	}
 
 	void ShowNoActor()
@@ -161,24 +161,27 @@ namespace Commands::NAFCommand
 		Animation::GraphManager::GetSingleton()->StopSyncing(actor);
 	}
 
-	bool DoOptimize(const std::string_view filePath, const std::string& savePath, uint8_t compressLevel, const Animation::OzzSkeleton* skele, bool verbose = true) {
+	std::unique_ptr<Animation::RawOzzAnimation> LoadRawAnimation(const std::string_view filePath, const Animation::OzzSkeleton* skele, bool verbose = true)
+	{
 		auto baseFile = Serialization::GLTFImport::LoadGLTF(filePath);
 		if (!baseFile || baseFile->asset.animations.empty()) {
 			if (verbose)
 				itfc->PrintLn("Failed to load file.");
-			return false;
+			return nullptr;
 		}
 
 		auto rawAnim = Serialization::GLTFImport::CreateRawAnimation(baseFile.get(), &baseFile->asset.animations[0], skele);
 		if (!rawAnim) {
 			if (verbose)
 				itfc->PrintLn("Failed to load anim.");
-			return false;
+			return nullptr;
 		}
 
-		baseFile.reset();
-		auto optimizedAsset = Serialization::GLTFExport::CreateOptimizedAsset(rawAnim.get(), skele->data.get(), compressLevel);
+		return rawAnim;
+	}
 
+	bool SaveOptimizedAsset(std::vector<std::byte>& optimizedAsset, const std::string& savePath, bool verbose = true)
+	{
 		try {
 			zstr::ofstream file(savePath, std::ios::binary);
 			file.write(reinterpret_cast<char*>(optimizedAsset.data()), optimizedAsset.size());
@@ -191,6 +194,142 @@ namespace Commands::NAFCommand
 		return true;
 	}
 
+	size_t CountKeys(const Animation::RawOzzAnimation* anim)
+	{
+		size_t result = 0;
+		for (auto& t : anim->data->tracks) {
+			result += t.rotations.size() + t.translations.size() + t.scales.size();
+		}
+		if (anim->faceData != nullptr) {
+			for (auto& t : anim->faceData->tracks) {
+				result += t.keyframes.size();
+			}
+		}
+		return result;
+	}
+
+	bool DoOptimize(const std::string_view filePath, const std::string& savePath, uint8_t compressLevel, const Animation::OzzSkeleton* skele, bool verbose = true) {
+		auto importStart = std::chrono::steady_clock::now();
+		auto rawAnim = LoadRawAnimation(filePath, skele, verbose);
+		if (!rawAnim)
+			return false;
+
+		auto exportStart = std::chrono::steady_clock::now();
+		const size_t inputKeys = CountKeys(rawAnim.get());
+		auto optimizedAsset = Serialization::GLTFExport::CreateOptimizedAsset(rawAnim.get(), skele->data.get(), compressLevel);
+		auto exportEnd = std::chrono::steady_clock::now();
+		if (!SaveOptimizedAsset(optimizedAsset, savePath, verbose))
+			return false;
+
+		if (verbose) {
+			//The export leaves the optimized keys in rawAnim.
+			itfc->PrintLn(std::format("Keys: {} -> {}, size: {:.1f} KB, import: {:.2f} ms, optimize + export: {:.2f} ms",
+				inputKeys,
+				CountKeys(rawAnim.get()),
+				optimizedAsset.size() / 1024.0,
+				std::chrono::duration<double, std::milli>(exportStart - importStart).count(),
+				std::chrono::duration<double, std::milli>(exportEnd - exportStart).count()));
+		}
+		return true;
+	}
+
+	//"test" sweeps levels 0-4, "test:1,3,4" only the listed ones. Returns nullopt if the argument isn't a test spec.
+	std::optional<std::vector<uint8_t>> ParseTestLevels(std::string_view arg)
+	{
+		constexpr std::string_view prefix = "test";
+		if (!arg.starts_with(prefix))
+			return std::nullopt;
+
+		std::vector<uint8_t> levels;
+		arg.remove_prefix(prefix.size());
+		if (arg.empty()) {
+			for (uint8_t i = 0; i < 5; i++) {
+				levels.push_back(i);
+			}
+			return levels;
+		}
+
+		if (arg.front() != ':')
+			return std::nullopt;
+
+		arg.remove_prefix(1);
+		while (!arg.empty()) {
+			auto comma = arg.find(',');
+			auto token = arg.substr(0, comma);
+			if (auto level = Util::String::StrToInt(std::string(token)); level.has_value()) {
+				uint8_t l = static_cast<uint8_t>(std::clamp(level.value(), 0, 255));
+				if (std::find(levels.begin(), levels.end(), l) == levels.end())
+					levels.push_back(l);
+			}
+			arg.remove_prefix(comma == std::string_view::npos ? arg.size() : comma + 1);
+		}
+		return levels;
+	}
+
+	//Only one sweep runs at a time, they already use every core between them.
+	std::atomic<bool> sweepRunning = false;
+
+	//Imports the clip once, then optimizes a copy per level in parallel. Returns the lines of a table comparing the levels.
+	//Doesn't touch the console, so it can run off the game thread.
+	std::vector<std::string> DoOptimizeSweep(const std::string& filePath, const std::vector<uint8_t>& levels, const Animation::OzzSkeleton* skele)
+	{
+		std::vector<std::string> lines;
+		auto baseAnim = LoadRawAnimation(filePath, skele, false);
+		if (!baseAnim) {
+			lines.emplace_back("Failed to load anim.");
+			return lines;
+		}
+
+		struct LevelResult
+		{
+			uint8_t level = 0;
+			bool saved = false;
+			size_t fileSize = 0;
+			size_t keyCount = 0;
+			double encodeMs = 0.0;
+		};
+
+		std::string savePath = std::filesystem::path(filePath).replace_extension().generic_string();
+		std::vector<LevelResult> results(levels.size());
+
+		std::vector<size_t> idxs(levels.size());
+		std::iota(idxs.begin(), idxs.end(), 0);
+		std::for_each(std::execution::par, idxs.begin(), idxs.end(), [&](size_t i) {
+			auto& r = results[i];
+			r.level = levels[i];
+
+			Animation::RawOzzAnimation anim;
+			anim.data = ozz::make_unique<ozz::animation::offline::RawAnimation>(*baseAnim->data);
+			if (baseAnim->faceData != nullptr) {
+				anim.faceData = std::make_unique<Animation::RawOzzFaceAnimation>(*baseAnim->faceData);
+			}
+
+			auto start = std::chrono::steady_clock::now();
+			auto optimizedAsset = Serialization::GLTFExport::CreateOptimizedAsset(&anim, skele->data.get(), r.level);
+			r.encodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			//The export leaves the optimized keys in anim.
+			r.keyCount = CountKeys(&anim);
+
+			std::string levelPath = std::format("{}_{}.glb", savePath, r.level);
+			r.saved = SaveOptimizedAsset(optimizedAsset, levelPath, false);
+			if (r.saved) {
+				std::error_code ec;
+				r.fileSize = std::filesystem::file_size(levelPath, ec);
+			}
+		});
+
+		lines.push_back(std::format("{:>5} {:>12} {:>10} {:>12}", "Level", "Size (KB)", "Keys", "Encode (ms)"));
+		for (auto& r : results) {
+			if (!r.saved) {
+				lines.push_back(std::format("{:>5} Failed to save file.", r.level));
+				continue;
+			}
+			lines.push_back(std::format("{:>5} {:>12.1f} {:>10} {:>12.2f}", r.level, r.fileSize / 1024.0, r.keyCount, r.encodeMs));
+		}
+		return lines;
+	}
+
 	void ProcessOptimizeCommand(uint64_t idxStart = 1, bool verbose = true)
 	{
 		if (args.size() < idxStart + 2) {
@@ -210,14 +349,39 @@ namespace Commands::NAFCommand
 
 		std::string filePath = (Util::String::GetDataPath() / args[idxStart].get()).generic_string();
 		
-		if (args[idxStart + 1].get() == "test") {
-			std::string savePath = std::filesystem::path(filePath).replace_extension().generic_string();
+		if (auto levels = ParseTestLevels(args[idxStart + 1].get()); levels.has_value()) {
+			if (levels->empty()) {
+				if (verbose)
+					itfc->PrintLn("No valid levels provided.");
+				return;
+			}
 
-			for (uint8_t i = 0; i < 5; i++) {
-				if (!DoOptimize(filePath, std::format("{}_{}.glb", savePath, i), i, skele.get(), true)) {
-					break;
-				}
+			if (sweepRunning.exchange(true)) {
+				if (verbose)
+					itfc->PrintLn("A level sweep is already running.");
+				return;
 			}
+
+			//The sweep runs on a worker so the console command returns right away. itfc is only valid for this command,
+			//so the finished table is handed back to the game thread and printed through the console log.
+			//The skeleton is moved into the worker to keep it alive for the sweep.
+			if (verbose)
+				itfc->PrintLn(std::format("Testing {} levels in the background...", levels->size()));
+
+			std::thread([verbose, filePath, levels = std::move(levels.value()), skele = std::move(skele)]() {
+				auto lines = DoOptimizeSweep(filePath, levels, skele.get());
+				if (verbose) {
+					lines.emplace_back("Done.");
+					Tasks::Input::GetSingleton()->AddTask([lines = std::move(lines)]() {
+						auto log = RE::ConsoleLog::GetSingleton();
+						for (auto& l : lines) {
+							log->PrintLine(l.c_str());
+						}
+					});
+				}
+				sweepRunning = false;
+			}).detach();
+			return;
 		} else {
 			auto arg2Int = Util::String::StrToInt(std::string(args[idxStart + 1]));
 			int compressLevel = arg2Int.has_value() ? std::clamp(arg2Int.value(), 0, 255) : 0;
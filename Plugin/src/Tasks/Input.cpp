@@ -13,9 +13,29 @@ namespace Tasks
 		callbacks[a_key] = a_callback;
 	}
 
+	void Input::AddTask(Task a_task)
+	{
+		std::unique_lock l{ taskLock };
+		tasks.push_back(std::move(a_task));
+	}
+
+	void Input::RunTasks()
+	{
+		std::vector<Task> pending;
+		{
+			std::unique_lock l{ taskLock };
+			pending.swap(tasks);
+		}
+
+		for (auto& t : pending) {
+			t();
+		}
+	}
+
 	static Util::VFuncHook<void(const RE::PlayerCamera*, const RE::InputEvent*)> PerformInputProcessingHook(459729, 0x1, "PlayerCamera::PerformInputProcessing",
 		[](const RE::PlayerCamera* a_camera, const RE::InputEvent* a_queueHead) {
 			static Input* m = Input::GetSingleton();
+			m->RunTasks();
 			for (auto curEvent = a_queueHead; curEvent != nullptr && curEvent->status != RE::InputEvent::Status::kStop; curEvent = curEvent->next) {
 				if (curEvent->eventType != RE::InputEvent::EventType::kButton) {
 					continue;
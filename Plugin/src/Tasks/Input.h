@@ -123,10 +123,17 @@ namespace Tasks
 		};
 
 		using ButtonCallback = std::function<void(BS_BUTTON_CODE a_key, bool a_down)>;
+		using Task = std::function<void()>;
 
 		static Input* GetSingleton();
 		void RegisterForKey(BS_BUTTON_CODE a_key, ButtonCallback a_callback);
 
+		//Runs a_task on the game thread at the start of the next input pass. Can be called from any thread.
+		void AddTask(Task a_task);
+		void RunTasks();
+
 		std::map<uint32_t, ButtonCallback> callbacks;
+		std::mutex taskLock;
+		std::vector<Task> tasks;
 	};
 }
\ No newline at end of file